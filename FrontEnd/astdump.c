@@ -0,0 +1,274 @@
+/*
+ * astdump.c -- print the syntax trees in an AST file (see astfile.h),
+ * using nothing but the reader library: "astdump file.ast" prints each
+ * function the way the DEBUG build of the compiler does with
+ * printSyntaxTree() (see print.c and process_syntax_tree.c), and
+ * "astdump -g file.ast" prints the globals first.
+ */
+
+#include "astread.h"
+
+static astfile *AF;
+
+static void indent(int n)
+{
+  while (n-- > 0) {
+    putchar(' ');
+  }
+}
+
+/*
+ * printSym(sp) -- print id(name=..., scope=...) for the symbol sp.
+ */
+static void printSym(astsym *sp)
+{
+  printf("id(name=%s, scope=%s)", (sp == NULL ? "?" : AstName(AF, sp)),
+	 (sp != NULL && sp->scope == Global ? "G" : "L"));
+}
+
+static char *binopName(int op)
+{
+  switch (op) {
+  case Plus:        return "+";
+  case BinaryMinus: return "-";
+  case Mult:        return "*";
+  case Div:         return "/";
+  case Equals:      return "==";
+  case Neq:         return "!=";
+  case Leq:         return "<=";
+  case Lt:          return "<";
+  case Geq:         return ">=";
+  case Gt:          return ">";
+  case LogicalAnd:  return "&&";
+  case LogicalOr:   return "||";
+  }
+  return "";
+}
+
+/*
+ * printTree(t, n, depth) -- print the tree t as printSyntaxTree(t, n,
+ * depth) does.
+ */
+static void printTree(tnode *t, int n, int depth)
+{
+  tnode *tntmp0;
+
+  printf("%d:", depth);
+  indent(n);
+
+  if (t == NULL) {
+    printf("-null-\n");
+    return;
+  }
+
+  switch (t->ntype) {
+  case Error:
+    printf("-error-\n");
+    break;
+
+  case Intcon:
+    printf("intcon(%d);\n", stIntcon(t));
+    break;
+
+  case Charcon:
+    printf("charcon(%d);\n", stCharcon(t));
+    break;
+
+  case Stringcon:
+    printf("str(%s);\n", stStringcon(t));
+    break;
+
+  case Var:
+    printSym(stVar(t));
+    printf(";\n");
+    break;
+
+  case ArraySubscript:
+    printf("arrayRef(");
+    printSym(stArraySubscript_Array(t));
+    printf(",\n");
+    printTree(stArraySubscript_Subscript(t), n+9, depth+1);
+    printf("%d:", depth);
+    indent(n+8);
+    printf(")\n");
+    break;
+
+  case UnaryMinus:
+  case LogicalNot:
+    printf("%s(\n", (t->ntype == UnaryMinus ? "-" : "!"));
+    printTree(stUnop_Op(t), n+2, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf(")\n");
+    break;
+
+  case Plus:
+  case BinaryMinus:
+  case Mult:
+  case Div:
+  case Equals:
+  case Neq:
+  case Leq:
+  case Lt:
+  case Geq:
+  case Gt:
+  case LogicalAnd:
+  case LogicalOr:
+    printf("%s(\n", binopName(t->ntype));
+    printTree(stBinop_Op1(t), n+2, depth+1);
+    printTree(stBinop_Op2(t), n+2, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf(")\n");
+    break;
+
+  case FunCall:
+    printf("CALL: callee=%s\n", AstName(AF, stFunCall_Fun(t)));
+    printf("%d:", depth);
+    indent(n);
+    printf("  args:\n");
+    printTree(stFunCall_Args(t), n+4, depth+1);
+    break;
+
+  case Assg:
+    printf("ASSG:\n");
+    printf("%d:", depth);
+    indent(n);
+    printf("  Lhs:\n");
+    printTree(stAssg_Lhs(t), n+4, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf("  Rhs:\n");
+    printTree(stAssg_Rhs(t), n+4, depth+1);
+    break;
+
+  case Return:
+    printf("RETURN:\n");
+    printTree(stReturn(t), n+2, depth+1);
+    break;
+
+  case For:
+    printf("FOR\n");
+    printf("%d:", depth);
+    indent(n);
+    printf("  init:\n");
+    printTree(stFor_Init(t), n+4, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf("  test:\n");
+    printTree(stFor_Test(t), n+4, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf("  update:\n");
+    printTree(stFor_Update(t), n+4, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf("  body:\n");
+    printTree(stFor_Body(t), n+4, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf("ENDFOR\n");
+    break;
+
+  case While:
+    printf("WHILE\n");
+    printTree(stWhile_Test(t), n+4, depth+1);
+    printf("%d:", depth);
+    printf("  body:\n ");
+    printTree(stWhile_Body(t), n+4, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf("ENDWHILE\n");
+    break;
+
+  case If:
+    printf("IF\n");
+    printTree(stIf_Test(t), n+4, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf("  then:\n");
+    printTree(stIf_Then(t), n+4, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf("  else:\n");
+    printTree(stIf_Else(t), n+4, depth+1);
+    printf("%d:", depth);
+    indent(n);
+    printf("ENDIF\n");
+    break;
+
+  case STnodeList:
+    printf("{\n");
+    for (tntmp0 = t; tntmp0 != NULL; tntmp0 = stList_Rest(tntmp0)) {
+      printTree(stList_Head(tntmp0), n+2, depth+1);
+    }
+    printf("%d:", depth);
+    indent(n);
+    printf("}\n");
+    break;
+
+  default:
+    fprintf(stderr, "Unknown syntax tree node type %d\n", t->ntype);
+  }
+}
+
+/*
+ * printGlobals() -- print the globals, one per line, with the formals
+ * of functions.
+ */
+static void printGlobals(void)
+{
+  static char *typeName[] = {"char", "int", "bool", "array", "func", "void", "error"};
+  astsym *sp, *fp;
+  int i, j;
+
+  for (i = 0; i < AstNumGlobals(AF); i++) {
+    sp = AstGlobal(AF, i);
+    printf("@@GLOBAL: %s %s", AstName(AF, sp),
+	   (sp->type >= 0 && sp->type <= t_Error ? typeName[sp->type] : "?"));
+    if (sp->type == t_Array) {
+      printf(" %s[%d]", typeName[sp->elt_type], sp->num_elts);
+    }
+    if (sp->type == t_Func) {
+      printf(" %s(", typeName[sp->ret_type]);
+      for (j = 0; (fp = AstFormal(AF, sp, j)) != NULL; j++) {
+	printf("%s%s %s%s", (j > 0 ? ", " : ""),
+	       typeName[fp->type == t_Array ? fp->elt_type : fp->type],
+	       AstName(AF, fp), (fp->type == t_Array ? "[]" : ""));
+      }
+      printf(")%s", (sp->fn_proto_state == FN_DEFINED ? "" : " proto"));
+    }
+    printf("%s\n", (sp->is_extern ? " extern" : ""));
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  bool globals = false;
+  int i;
+
+  if (argc > 1 && strcmp(argv[1], "-g") == 0) {
+    globals = true;
+    argc--, argv++;
+  }
+  if (argc != 2) {
+    fprintf(stderr, "Usage: astdump [-g] file.ast\n");
+    exit(1);
+  }
+  if ((AF = AstOpen(argv[1])) == NULL) {
+    exit(1);
+  }
+
+  if (globals) {
+    printGlobals();
+  }
+  for (i = 0; i < AstNumFunctions(AF); i++) {
+    printf("@@FUN: %s\n", AstName(AF, AstFunctionSym(AF, i)));
+    printf("@@BODY:\n");
+    printTree(AstBody(AF, i), 4, 0);
+    printf("-----\n");
+  }
+
+  AstClose(AF);
+  return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * astfile.h -- the layout of an AST file, as written by -fdump-ast (see
+ * astwrite.c) and read by the library in astread.c.
+ *
+ * An AST file holds the syntax trees of the functions of a program and
+ * its symbol tables, laid out so that it can be mapped into memory and
+ * used where it lies.  All numbers are in the byte order of the machine
+ * that wrote the file, which the header records; offsets are from the
+ * start of the file, and every array starts at a multiple of 8.
+ *
+ *   header      astheader
+ *   functions   for each function: its nodes (tnode, as in syntax-tree.h,
+ *               node 0 unused), its kids (the NodeKids of its statement
+ *               nodes), its refs, and its local symbols (astsym)
+ *   globals     astsym, in order of declaration
+ *   formals     astsym: the formals of the functions among the globals
+ *   funcs       astfunc, one per function, in order of definition
+ *   strings     NUL-terminated strings
+ *
+ * The nodes refer to each other, and to their kids, by index within the
+ * function, exactly as in memory.  Where a node in memory has an index
+ * into NodePtrs, here it has an index into the refs of its function: for
+ * a Stringcon node the ref is the offset of the string in the strings;
+ * for a Var, ArraySubscript or FunCall node it is AST_REFSYM(i, local),
+ * for the i'th global or the i'th local symbol of the function.
+ */
+
+#ifndef _ASTFILE_H_
+#define _ASTFILE_H_
+
+#include <stdint.h>
+
+#define AST_MAGIC      "C--AST\n"    /* 8 bytes with the NUL */
+#define AST_VERSION    1
+#define AST_BYTEORDER  0x01020304
+
+#define AST_REFSYM(i, local)  (((uint32_t) (i) << 1) | ((local) ? 1 : 0))
+#define AST_REFINDEX(r)       ((r) >> 1)
+#define AST_REFLOCAL(r)       ((r) & 1)
+#define AST_NOREF             0xffffffff   /* no symbol (after an error) */
+
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteorder;
+  uint32_t nodesize;          /* sizeof(tnode) */
+  uint32_t nfuncs, nglobals, nformals;
+  uint64_t funcs, globals, formals, strings;   /* offsets */
+  uint64_t stringsize;
+  uint64_t filesize;
+} astheader;
+
+typedef struct {
+  uint32_t name;              /* offset of the name in the strings */
+  int32_t type;
+  int32_t elt_type;
+  int32_t num_elts;
+  int32_t ret_type;
+  int32_t level;
+  uint32_t formals;           /* for a function: index of its first formal */
+  uint32_t nformals;
+  uint8_t scope;
+  uint8_t formal;
+  uint8_t is_extern;
+  uint8_t fn_proto_state;
+} astsym;
+
+typedef struct {
+  uint32_t sym;               /* index of the function among the globals */
+  uint32_t body;              /* index of the root of its body */
+  uint32_t nnodes, nkids, nrefs, nlocals;
+  uint64_t nodes, kids, refs, locals;          /* offsets */
+} astfunc;
+
+#endif  /* _ASTFILE_H_ */
@@ -0,0 +1,529 @@
+/*
+ * astread.c -- reading AST files (see astfile.h) in place.
+ *
+ * AstOpen() maps a file into memory and checks that its header and
+ * tables are sound; nothing is read or converted beyond that.  The nodes
+ * of the current function (see AstBody()) are used where they lie in
+ * the mapping: the accessors follow the indices in them the way those in
+ * syntax-tree.c do, checking each against the size of the function.
+ *
+ * This file is the whole of libast.a, and must not depend on the rest
+ * of the front end.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "astread.h"
+
+struct astfile {
+  char *base;               /* the mapping */
+  size_t size;
+  astheader *hdr;
+  astsym *globals, *formals;
+  astfunc *funcs;
+  char *strings;
+};
+
+/*
+ * The current function of the calling thread, set by AstBody().
+ */
+static THREAD_LOCAL astfile *CurrFile;
+static THREAD_LOCAL astfunc *CurrFunc;
+static THREAD_LOCAL tnode *Nodes;
+static THREAD_LOCAL uint32_t *Kids, *Refs;
+static THREAD_LOCAL astsym *Locals;
+
+static char *astNodeTypeName[NNODETYPES] =
+  {
+    "Error", "Intcon", "Charcon", "Stringcon", "Var", "ArraySubscript",
+    "Plus", "UnaryMinus", "BinaryMinus", "Mult", "Div", "Equals", "Neq",
+    "Leq", "Lt", "Geq", "Gt", "LogicalAnd", "LogicalOr", "LogicalNot",
+    "FunCall", "Assg", "Return", "For", "While", "If", "STnodeList"
+  };
+
+/*********************************************************************
+ *                                                                   *
+ *                             THE FILE                              *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * InFile(af, off, n, size) -- true if an array of n items of size bytes
+ * at offset off lies within the file af and is aligned.
+ */
+static bool InFile(astfile *af, uint64_t off, uint64_t n, size_t size)
+{
+  return (off % 8 == 0 && off <= af->size && n <= (af->size - off) / size);
+}
+
+/*
+ * AstOpen(path) -- map the AST file path into memory.  Returns NULL,
+ * with a message on stderr, if it can't be read or is not an AST file
+ * this library understands.
+ */
+astfile *AstOpen(char *path)
+{
+  astfile *af;
+  astheader *hdr;
+  astfunc *afp;
+  struct stat st;
+  char *why = NULL;
+  unsigned i;
+  int fd;
+
+  if ((fd = open(path, O_RDONLY)) < 0 || fstat(fd, &st) < 0) {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    if (fd >= 0) close(fd);
+    return NULL;
+  }
+  if (st.st_size < (off_t) sizeof(astheader)) {
+    fprintf(stderr, "%s: not an AST file\n", path);
+    close(fd);
+    return NULL;
+  }
+
+  if ((af = calloc(1, sizeof(astfile))) == NULL) {
+    fprintf(stderr, "Not enough memory\n");
+    abort();
+  }
+  af->size = st.st_size;
+  af->base = mmap(NULL, af->size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (af->base == MAP_FAILED) {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    free(af);
+    return NULL;
+  }
+
+  af->hdr = hdr = (astheader *) af->base;
+  if (memcmp(hdr->magic, AST_MAGIC, sizeof(hdr->magic)) != 0) {
+    why = "not an AST file";
+  }
+  else if (hdr->byteorder != AST_BYTEORDER) {
+    why = "written on a machine with another byte order";
+  }
+  else if (hdr->version != AST_VERSION || hdr->nodesize != sizeof(tnode)) {
+    why = "written by another version of the compiler";
+  }
+  else if (hdr->filesize != af->size
+	   || !InFile(af, hdr->globals, hdr->nglobals, sizeof(astsym))
+	   || !InFile(af, hdr->formals, hdr->nformals, sizeof(astsym))
+	   || !InFile(af, hdr->funcs, hdr->nfuncs, sizeof(astfunc))
+	   || !InFile(af, hdr->strings, hdr->stringsize, 1)
+	   || hdr->stringsize == 0
+	   || af->base[hdr->strings + hdr->stringsize - 1] != '\0') {
+    why = "truncated or damaged";
+  }
+  else {
+    af->globals = (astsym *) (af->base + hdr->globals);
+    af->formals = (astsym *) (af->base + hdr->formals);
+    af->funcs = (astfunc *) (af->base + hdr->funcs);
+    af->strings = af->base + hdr->strings;
+    for (i = 0; i < hdr->nfuncs && why == NULL; i++) {
+      afp = &af->funcs[i];
+      if (!InFile(af, afp->nodes, afp->nnodes, sizeof(tnode))
+	  || !InFile(af, afp->kids, afp->nkids, sizeof(uint32_t))
+	  || !InFile(af, afp->refs, afp->nrefs, sizeof(uint32_t))
+	  || !InFile(af, afp->locals, afp->nlocals, sizeof(astsym))
+	  || afp->sym >= hdr->nglobals
+	  || (afp->body != 0 && afp->body >= afp->nnodes)) {
+	why = "truncated or damaged";
+      }
+    }
+  }
+
+  if (why != NULL) {
+    fprintf(stderr, "%s: %s\n", path, why);
+    AstClose(af);
+    return NULL;
+  }
+
+  return af;
+}
+
+/*
+ * AstClose(af) -- unmap the file af.  Trees from it can't be used after
+ * this.
+ */
+void AstClose(astfile *af)
+{
+  if (CurrFile == af) {
+    CurrFile = NULL;
+    CurrFunc = NULL;
+  }
+  munmap(af->base, af->size);
+  free(af);
+}
+
+/*
+ * AstNumGlobals(af), AstGlobal(af, i) -- the number of globals in af,
+ * and the i'th of them in order of declaration.
+ */
+int AstNumGlobals(astfile *af)
+{
+  return af->hdr->nglobals;
+}
+
+astsym *AstGlobal(astfile *af, int i)
+{
+  assert(i >= 0 && (unsigned) i < af->hdr->nglobals);
+  return &af->globals[i];
+}
+
+/*
+ * AstFormal(af, fn, i) -- the i'th formal, from 0, of the function fn
+ * among the globals of af, or NULL if it has no more than i.
+ */
+astsym *AstFormal(astfile *af, astsym *fn, int i)
+{
+  if (i < 0 || (unsigned) i >= fn->nformals
+      || fn->formals + i >= af->hdr->nformals) {
+    return NULL;
+  }
+  return &af->formals[fn->formals + i];
+}
+
+/*
+ * AstName(af, sp) -- the name of the symbol sp of af.
+ */
+char *AstName(astfile *af, astsym *sp)
+{
+  return (sp->name < af->hdr->stringsize ? af->strings + sp->name : "");
+}
+
+/*
+ * AstNumFunctions(af), AstFunctionSym(af, i) -- the number of function
+ * definitions in af, and the global of the i'th of them, in order of
+ * definition.
+ */
+int AstNumFunctions(astfile *af)
+{
+  return af->hdr->nfuncs;
+}
+
+astsym *AstFunctionSym(astfile *af, int i)
+{
+  assert(i >= 0 && (unsigned) i < af->hdr->nfuncs);
+  return &af->globals[af->funcs[i].sym];
+}
+
+/*
+ * AstBody(af, i) -- make the i'th function of af the current function
+ * of the calling thread, and return the root of its body.
+ */
+tnode *AstBody(astfile *af, int i)
+{
+  astfunc *afp;
+
+  assert(i >= 0 && (unsigned) i < af->hdr->nfuncs);
+  afp = &af->funcs[i];
+  CurrFile = af;
+  CurrFunc = afp;
+  Nodes = (tnode *) (af->base + afp->nodes);
+  Kids = (uint32_t *) (af->base + afp->kids);
+  Refs = (uint32_t *) (af->base + afp->refs);
+  Locals = (astsym *) (af->base + afp->locals);
+
+  return (afp->body == 0 ? NULL : Nodes + afp->body);
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                         ACCESSOR FUNCTIONS                        *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * Bad(where, what) -- report a node that does not fit the current
+ * function, and give up.
+ */
+static void Bad(char *where, char *what)
+{
+  fprintf(stderr, "[ERROR] %s: %s\n", where, what);
+  abort();
+}
+
+/*
+ * Node(i, where) -- the node with index i in the current function.
+ */
+static tnode *Node(uint32_t i, char *where)
+{
+  if (CurrFunc == NULL) {
+    Bad(where, "no current function");
+  }
+  if (i == 0) {
+    return NULL;
+  }
+  if (i >= CurrFunc->nnodes) {
+    Bad(where, "node index out of range");
+  }
+  return Nodes + i;
+}
+
+/*
+ * Kid(t, k, where) -- the k'th child of the statement node t.
+ */
+static tnode *Kid(tnode *t, int k, char *where)
+{
+  if (t->a + k >= CurrFunc->nkids) {
+    Bad(where, "kids index out of range");
+  }
+  return Node(Kids[t->a + k], where);
+}
+
+/*
+ * Ref(t, where) -- the ref of the node t.
+ */
+static uint32_t Ref(tnode *t, char *where)
+{
+  if (t->a >= CurrFunc->nrefs) {
+    Bad(where, "ref index out of range");
+  }
+  return Refs[t->a];
+}
+
+/*
+ * Sym(t, where) -- the symbol that the Var, ArraySubscript or FunCall
+ * node t refers to.
+ */
+static astsym *Sym(tnode *t, char *where)
+{
+  uint32_t r = Ref(t, where);
+
+  if (r == AST_NOREF) {
+    return NULL;
+  }
+  if (AST_REFLOCAL(r)) {
+    if (AST_REFINDEX(r) >= CurrFunc->nlocals) {
+      Bad(where, "local symbol out of range");
+    }
+    return &Locals[AST_REFINDEX(r)];
+  }
+  if (AST_REFINDEX(r) >= CurrFile->hdr->nglobals) {
+    Bad(where, "global symbol out of range");
+  }
+  return &CurrFile->globals[AST_REFINDEX(r)];
+}
+
+/*
+ * chkNodeType(t, expected, where) -- check that t is a node of type
+ * expected, as in syntax-tree.c.
+ */
+static void chkNodeType(tnode *t, int expected, char *where)
+{
+  if (t == NULL) {
+    fprintf(stderr, "[ERROR] %s: NULL argument\n", where);
+    abort();
+  }
+
+  if (t->ntype != expected) {
+    fprintf(stderr, "[ERROR] %s: expected type %s, given %s\n",
+	    where,
+	    astNodeTypeName[expected],
+	    (t->ntype < NNODETYPES ? astNodeTypeName[t->ntype] : "?"));
+    abort();
+  }
+}
+
+/*
+ * chkBinop(t, where) -- check that t is a binary operator node.
+ */
+static void chkBinop(tnode *t, char *where)
+{
+  if (t == NULL) {
+    fprintf(stderr, "[ERROR] %s: NULL argument\n", where);
+    abort();
+  }
+
+  switch (t->ntype) {
+  case Plus:
+  case BinaryMinus:
+  case Mult:
+  case Div:
+  case Equals:
+  case Neq:
+  case Leq:
+  case Lt:
+  case Geq:
+  case Gt:
+  case LogicalAnd:
+  case LogicalOr:
+    return;
+
+  default:
+    fprintf(stderr, "[ERROR] %s: expected binary operator, given %s\n",
+	    where, (t->ntype < NNODETYPES ? astNodeTypeName[t->ntype] : "?"));
+    abort();
+  }
+}
+
+/*
+ * The accessors: each returns what the function of the same name in
+ * protos.h does, for a node of the current function.
+ */
+int stIntcon(tnode *t)
+{
+  chkNodeType(t, Intcon, "stIntcon");
+  return (int) t->a;
+}
+
+int stCharcon(tnode *t)
+{
+  chkNodeType(t, Charcon, "stCharcon");
+  return (int) t->a;
+}
+
+char *stStringcon(tnode *t)
+{
+  uint32_t r;
+
+  chkNodeType(t, Stringcon, "stStringcon");
+  r = Ref(t, "stStringcon");
+  if (r >= CurrFile->hdr->stringsize) {
+    Bad("stStringcon", "string out of range");
+  }
+  return CurrFile->strings + r;
+}
+
+astsym *stVar(tnode *t)
+{
+  chkNodeType(t, Var, "stVar");
+  return Sym(t, "stVar");
+}
+
+astsym *stArraySubscript_Array(tnode *t)
+{
+  chkNodeType(t, ArraySubscript, "stArraySubscript_Array");
+  return Sym(t, "stArraySubscript_Array");
+}
+
+tnode *stArraySubscript_Subscript(tnode *t)
+{
+  chkNodeType(t, ArraySubscript, "stArraySubscript_Subscript");
+  return Node(t->b, "stArraySubscript_Subscript");
+}
+
+tnode *stBinop_Op1(tnode *t)
+{
+  chkBinop(t, "stBinop_Op1");
+  return Node(t->a, "stBinop_Op1");
+}
+
+tnode *stBinop_Op2(tnode *t)
+{
+  chkBinop(t, "stBinop_Op2");
+  return Node(t->b, "stBinop_Op2");
+}
+
+tnode *stUnop_Op(tnode *t)
+{
+  if (t == NULL) {
+    fprintf(stderr, "[ERROR] stUnop_Op: NULL argument\n");
+    abort();
+  }
+  if (t->ntype != UnaryMinus && t->ntype != LogicalNot) {
+    fprintf(stderr, "[ERROR] stUnop_Op: expected unary operator, given %s\n",
+	    (t->ntype < NNODETYPES ? astNodeTypeName[t->ntype] : "?"));
+    abort();
+  }
+  return Node(t->a, "stUnop_Op");
+}
+
+astsym *stFunCall_Fun(tnode *t)
+{
+  chkNodeType(t, FunCall, "stFunCall_Fun");
+  return Sym(t, "stFunCall_Fun");
+}
+
+tnode *stFunCall_Args(tnode *t)
+{
+  chkNodeType(t, FunCall, "stFunCall_Args");
+  return Node(t->b, "stFunCall_Args");
+}
+
+tnode *stAssg_Lhs(tnode *t)
+{
+  chkNodeType(t, Assg, "stAssg_Lhs");
+  return Node(t->a, "stAssg_Lhs");
+}
+
+tnode *stAssg_Rhs(tnode *t)
+{
+  chkNodeType(t, Assg, "stAssg_Rhs");
+  return Node(t->b, "stAssg_Rhs");
+}
+
+tnode *stReturn(tnode *t)
+{
+  chkNodeType(t, Return, "stReturn");
+  return Kid(t, 0, "stReturn");
+}
+
+tnode *stFor_Init(tnode *t)
+{
+  chkNodeType(t, For, "stFor_Init");
+  return Kid(t, 0, "stFor_Init");
+}
+
+tnode *stFor_Test(tnode *t)
+{
+  chkNodeType(t, For, "stFor_Test");
+  return Kid(t, 1, "stFor_Test");
+}
+
+tnode *stFor_Update(tnode *t)
+{
+  chkNodeType(t, For, "stFor_Update");
+  return Kid(t, 2, "stFor_Update");
+}
+
+tnode *stFor_Body(tnode *t)
+{
+  chkNodeType(t, For, "stFor_Body");
+  return Kid(t, 3, "stFor_Body");
+}
+
+tnode *stWhile_Test(tnode *t)
+{
+  chkNodeType(t, While, "stWhile_Test");
+  return Kid(t, 0, "stWhile_Test");
+}
+
+tnode *stWhile_Body(tnode *t)
+{
+  chkNodeType(t, While, "stWhile_Body");
+  return Kid(t, 1, "stWhile_Body");
+}
+
+tnode *stIf_Test(tnode *t)
+{
+  chkNodeType(t, If, "stIf_Test");
+  return Kid(t, 0, "stIf_Test");
+}
+
+tnode *stIf_Then(tnode *t)
+{
+  chkNodeType(t, If, "stIf_Then");
+  return Kid(t, 1, "stIf_Then");
+}
+
+tnode *stIf_Else(tnode *t)
+{
+  chkNodeType(t, If, "stIf_Else");
+  return Kid(t, 2, "stIf_Else");
+}
+
+tnode *stList_Head(tnode *t)
+{
+  chkNodeType(t, STnodeList, "stList_Head");
+  return Node(t->a, "stList_Head");
+}
+
+tnode *stList_Rest(tnode *t)
+{
+  chkNodeType(t, STnodeList, "stList_Rest");
+  return Node(t->b, "stList_Rest");
+}
@@ -0,0 +1,67 @@
+/*
+ * astread.h -- reading the AST files written by -fdump-ast (see
+ * astfile.h) in place, for tools that work on the syntax trees of a
+ * program without running the front end.  Link with libast.a.
+ *
+ * AstBody() makes one of the functions in a file the current function of
+ * the calling thread, and returns the root of its body; the accessors
+ * below, which have the same names as those in protos.h, then work on
+ * its nodes, except that symbols are astsym records in the file instead
+ * of symbol table entries (use AstName() for their names).  The nodes
+ * are in the file's read-only mapping, and must not be changed.
+ */
+
+#ifndef _ASTREAD_H_
+#define _ASTREAD_H_
+
+#include "global.h"
+#include "syntax-tree.h"
+#include "astfile.h"
+
+typedef struct astfile astfile;
+
+astfile *AstOpen(char *path);
+void AstClose(astfile *af);
+
+int AstNumGlobals(astfile *af);
+astsym *AstGlobal(astfile *af, int i);
+astsym *AstFormal(astfile *af, astsym *fn, int i);
+char *AstName(astfile *af, astsym *sp);
+
+int AstNumFunctions(astfile *af);
+astsym *AstFunctionSym(astfile *af, int i);
+tnode *AstBody(astfile *af, int i);
+
+/*********************************************************************
+ *                                                                   *
+ *         SYNTAX TREE ACCESSOR FUNCTIONS (see protos.h)             *
+ *                                                                   *
+ *********************************************************************/
+
+int stIntcon(tnode *t);
+int stCharcon(tnode *t);
+char *stStringcon(tnode *t);
+astsym *stVar(tnode *t);
+astsym *stArraySubscript_Array(tnode *t);
+tnode *stArraySubscript_Subscript(tnode *t);
+tnode *stBinop_Op1(tnode *t);
+tnode *stBinop_Op2(tnode *t);
+tnode *stUnop_Op(tnode *t);
+astsym *stFunCall_Fun(tnode *t);
+tnode *stFunCall_Args(tnode *t);
+tnode *stAssg_Lhs(tnode *t);
+tnode *stAssg_Rhs(tnode *t);
+tnode *stReturn(tnode *t);
+tnode *stFor_Init(tnode *t);
+tnode *stFor_Test(tnode *t);
+tnode *stFor_Update(tnode *t);
+tnode *stFor_Body(tnode *t);
+tnode *stWhile_Test(tnode *t);
+tnode *stWhile_Body(tnode *t);
+tnode *stIf_Test(tnode *t);
+tnode *stIf_Then(tnode *t);
+tnode *stIf_Else(tnode *t);
+tnode *stList_Head(tnode *t);
+tnode *stList_Rest(tnode *t);
+
+#endif  /* _ASTREAD_H_ */
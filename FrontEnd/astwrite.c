@@ -0,0 +1,400 @@
+/*
+ * astwrite.c -- writing the syntax trees and symbol tables of a program
+ * to an AST file (see astfile.h) for -fdump-ast.
+ *
+ * A function's tree is captured by AstCapture() right after it has been
+ * processed, on whichever thread processed it (see backend.c and
+ * split.c): the nodes and kids are copied as they are, and the entries
+ * of NodePtrs are turned into refs, with the strings and the local
+ * symbols copied into the capture.  The capture goes along with the
+ * function's output to the thread of the compilation, which adds it to
+ * the file with AstEmit() in the order the output is written; so the
+ * functions are in the file in order of definition, whatever the number
+ * of threads.  AstFinish() adds the globals once the whole program has
+ * been parsed, and writes the file.
+ */
+
+#include <errno.h>
+#include "global.h"
+#include "symbol-table.h"
+#include "syntax-tree.h"
+#include "astfile.h"
+#include "astwrite.h"
+
+bool ast_dump = false;      /* set from the command line, for all compilations */
+
+/*
+ * A pool of NUL-terminated strings, referred to by offset.
+ */
+typedef struct {
+  char *buf;
+  size_t len, max;
+} strpool;
+
+struct astblob {
+  uint32_t sym;             /* index of the function among the globals */
+  uint32_t body;
+  uint32_t nnodes, nkids, nrefs, nlocals;
+  tnode *nodes;
+  unsigned *kids;
+  uint32_t *refs;           /* string refs are offsets in strings */
+  astsym *locals;           /* names are offsets in strings */
+  strpool strings;
+};
+
+/*
+ * What has been emitted so far by the current compilation: the nodes,
+ * kids, refs and locals of the functions in Data, the function table in
+ * Funcs, with offsets from the start of Data, and the strings in Pool.
+ */
+static THREAD_LOCAL strpool Data;
+static THREAD_LOCAL strpool Pool;
+static THREAD_LOCAL astfunc *Funcs;
+static THREAD_LOCAL unsigned nFuncs, maxFuncs;
+
+/*
+ * PoolAdd(p, s, n) -- append the n bytes at s to p; returns their offset.
+ */
+static uint32_t PoolAdd(strpool *p, void *s, size_t n)
+{
+  size_t off = p->len;
+
+  if (n == 0) {
+    return off;
+  }
+  if (p->len + n > p->max) {
+    p->max = (p->max == 0 ? 4096 : p->max);
+    while (p->len + n > p->max) {
+      p->max *= 2;
+    }
+    if ((p->buf = realloc(p->buf, p->max)) == NULL) {
+      fprintf(stderr, "Not enough memory\n");
+      abort();
+    }
+  }
+  memcpy(p->buf + off, s, n);
+  p->len += n;
+
+  return off;
+}
+
+/*
+ * PoolString(p, s) -- append the string s to p; returns its offset.
+ */
+static uint32_t PoolString(strpool *p, char *s)
+{
+  return PoolAdd(p, s, strlen(s) + 1);
+}
+
+/*
+ * PoolAlign(p) -- pad p with zeroes to a multiple of 8 bytes.
+ */
+static void PoolAlign(strpool *p)
+{
+  static char zeroes[8];
+
+  PoolAdd(p, zeroes, -p->len & 7);
+}
+
+/*
+ * AstSymRecord(asp, stptr, name) -- fill in the AST file record asp for
+ * the symbol stptr, whose name is at offset name.
+ */
+void AstSymRecord(astsym *asp, symtabnode *stptr, uint32_t name)
+{
+  memset(asp, 0, sizeof(*asp));
+  asp->name = name;
+  asp->type = stptr->type;
+  asp->elt_type = stptr->elt_type;
+  asp->num_elts = stptr->num_elts;
+  asp->ret_type = stptr->ret_type;
+  asp->level = stptr->level;
+  asp->scope = stptr->scope;
+  asp->formal = stptr->formal;
+  asp->is_extern = stptr->is_extern;
+  asp->fn_proto_state = stptr->fn_proto_state;
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                             CAPTURE                               *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * LocalIndex(blob, syms, tab, size, stptr) -- return the number of the
+ * local symbol stptr in blob, adding it to syms if it is not there yet.
+ * tab is an open hash table of size entries (a power of 2) holding the
+ * numbers + 1 of the symbols in syms.
+ */
+static uint32_t LocalIndex(struct astblob *blob, symtabnode **syms,
+			   uint32_t *tab, unsigned size, symtabnode *stptr)
+{
+  unsigned h = ((uintptr_t) stptr >> 4) & (size - 1);
+
+  while (tab[h] != 0) {
+    if (syms[tab[h] - 1] == stptr) {
+      return tab[h] - 1;
+    }
+    h = (h + 1) & (size - 1);
+  }
+  syms[blob->nlocals] = stptr;
+  tab[h] = ++blob->nlocals;
+
+  return blob->nlocals - 1;
+}
+
+/*
+ * AstCapture(fn, body) -- capture the tree of the function fn with body
+ * body, which the accessors of the calling thread look at, for AstEmit().
+ * Returns NULL unless ast_dump is set.
+ */
+struct astblob *AstCapture(symtabnode *fn, tnode *body)
+{
+  struct astblob *blob;
+  symtabnode **syms, *stptr;
+  uint32_t *tab;
+  unsigned nptrs, size, i;
+  tnode *tn;
+
+  if (!ast_dump) {
+    return NULL;
+  }
+
+  blob = zalloc(sizeof(struct astblob));
+  SynTreeExtent(&blob->nnodes, &blob->nkids, &nptrs);
+  blob->sym = fn->index;
+  blob->body = NodeIndex(body);
+  blob->nrefs = nptrs;
+
+  blob->nodes = zalloc((blob->nnodes > 0 ? blob->nnodes : 1) * sizeof(tnode));
+  blob->kids = zalloc((blob->nkids > 0 ? blob->nkids : 1) * sizeof(unsigned));
+  blob->refs = zalloc((nptrs > 0 ? nptrs : 1) * sizeof(uint32_t));
+  memcpy(blob->nodes, NodeTab, blob->nnodes * sizeof(tnode));
+  memcpy(blob->kids, NodeKids, blob->nkids * sizeof(unsigned));
+
+  for (size = 16; size < 2 * nptrs; size *= 2) {
+    continue;
+  }
+  tab = zalloc(size * sizeof(uint32_t));
+  syms = zalloc((nptrs > 0 ? nptrs : 1) * sizeof(symtabnode *));
+
+  for (i = 1; i < blob->nnodes; i++) {
+    tn = &NodeTab[i];
+    switch (tn->ntype) {
+    case Stringcon:
+      blob->refs[tn->a] = PoolString(&blob->strings, StrVal(tn));
+      break;
+
+    case Var:
+    case ArraySubscript:
+    case FunCall:
+      if ((stptr = SymTabPtr(tn)) == NULL) {
+	blob->refs[tn->a] = AST_NOREF;
+      }
+      else if (stptr->scope == Global) {
+	blob->refs[tn->a] = AST_REFSYM(stptr->index, false);
+      }
+      else {
+	blob->refs[tn->a] = AST_REFSYM(LocalIndex(blob, syms, tab, size, stptr), true);
+      }
+      break;
+    }
+  }
+
+  blob->locals = zalloc((blob->nlocals > 0 ? blob->nlocals : 1) * sizeof(astsym));
+  for (i = 0; i < blob->nlocals; i++) {
+    AstSymRecord(&blob->locals[i], syms[i], PoolString(&blob->strings, syms[i]->name));
+  }
+
+  free(tab);
+  free(syms);
+  return blob;
+}
+
+/*
+ * AstFree(blob) -- throw away a capture that is not going to be emitted.
+ */
+void AstFree(struct astblob *blob)
+{
+  if (blob == NULL) {
+    return;
+  }
+  free(blob->nodes);
+  free(blob->kids);
+  free(blob->refs);
+  free(blob->locals);
+  free(blob->strings.buf);
+  free(blob);
+}
+
+/*
+ * AstEmit(blob) -- add the function captured in blob to the file of the
+ * current compilation, after the ones emitted before it, and free blob.
+ * Does nothing if blob is NULL.
+ */
+void AstEmit(struct astblob *blob)
+{
+  astfunc *afp;
+  uint32_t base;
+  unsigned i;
+
+  if (blob == NULL) {
+    return;
+  }
+
+  /*
+   * The strings of the capture go into the pool as they are, so the
+   * offsets in it just move up by where they land.
+   */
+  if (Pool.len == 0) {
+    PoolString(&Pool, "");
+  }
+  base = PoolAdd(&Pool, blob->strings.buf, blob->strings.len);
+  for (i = 1; i < blob->nnodes; i++) {
+    if (blob->nodes[i].ntype == Stringcon) {
+      blob->refs[blob->nodes[i].a] += base;
+    }
+  }
+  for (i = 0; i < blob->nlocals; i++) {
+    blob->locals[i].name += base;
+  }
+
+  if (nFuncs >= maxFuncs) {
+    maxFuncs = (maxFuncs == 0 ? 64 : 2 * maxFuncs);
+    if ((Funcs = realloc(Funcs, maxFuncs * sizeof(astfunc))) == NULL) {
+      fprintf(stderr, "Not enough memory\n");
+      abort();
+    }
+  }
+  afp = &Funcs[nFuncs++];
+  memset(afp, 0, sizeof(*afp));
+  afp->sym = blob->sym;
+  afp->body = blob->body;
+  afp->nnodes = blob->nnodes;
+  afp->nkids = blob->nkids;
+  afp->nrefs = blob->nrefs;
+  afp->nlocals = blob->nlocals;
+
+  afp->nodes = Data.len;
+  PoolAdd(&Data, blob->nodes, blob->nnodes * sizeof(tnode));
+  PoolAlign(&Data);
+  afp->kids = Data.len;
+  PoolAdd(&Data, blob->kids, blob->nkids * sizeof(unsigned));
+  PoolAlign(&Data);
+  afp->refs = Data.len;
+  PoolAdd(&Data, blob->refs, blob->nrefs * sizeof(uint32_t));
+  PoolAlign(&Data);
+  afp->locals = Data.len;
+  PoolAdd(&Data, blob->locals, blob->nlocals * sizeof(astsym));
+  PoolAlign(&Data);
+
+  AstFree(blob);
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                            THE FILE                               *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * AstDiscard() -- throw away what the current compilation has emitted.
+ */
+void AstDiscard(void)
+{
+  free(Data.buf);
+  free(Pool.buf);
+  free(Funcs);
+  memset(&Data, 0, sizeof(Data));
+  memset(&Pool, 0, sizeof(Pool));
+  Funcs = NULL;
+  nFuncs = maxFuncs = 0;
+}
+
+/*
+ * AstFinish(path) -- write the AST file for the current compilation to
+ * path: the functions emitted, and the globals in the Global table.
+ * Returns false, with a message on errfp, if the file can't be written.
+ */
+bool AstFinish(char *path)
+{
+  astheader hdr;
+  strpool globals, formals;
+  symtabnode **syms, *formal;
+  astsym as, af;
+  int nsyms, i;
+  unsigned j;
+  uint64_t off;
+  FILE *fp;
+  bool ok;
+
+  memset(&globals, 0, sizeof(globals));
+  memset(&formals, 0, sizeof(formals));
+  if (Pool.len == 0) {
+    PoolString(&Pool, "");
+  }
+
+  memset(&hdr, 0, sizeof(hdr));
+  syms = SymTabGlobals(&nsyms);
+  for (i = 0; i < nsyms; i++) {
+    memset(&as, 0, sizeof(as));
+    if (syms[i] != NULL) {
+      AstSymRecord(&as, syms[i], PoolString(&Pool, syms[i]->name));
+      if (syms[i]->type == t_Func) {
+	as.formals = hdr.nformals;
+	for (formal = syms[i]->formals; formal != NULL; formal = formal->next) {
+	  AstSymRecord(&af, formal, PoolString(&Pool, formal->name));
+	  PoolAdd(&formals, &af, sizeof(af));
+	  as.nformals++;
+	  hdr.nformals++;
+	}
+      }
+    }
+    PoolAdd(&globals, &as, sizeof(as));
+  }
+  free(syms);
+  PoolAlign(&globals);
+  PoolAlign(&formals);
+
+  memcpy(hdr.magic, AST_MAGIC, sizeof(hdr.magic));
+  hdr.version = AST_VERSION;
+  hdr.byteorder = AST_BYTEORDER;
+  hdr.nodesize = sizeof(tnode);
+  hdr.nfuncs = nFuncs;
+  hdr.nglobals = nsyms;
+  off = (sizeof(hdr) + 7) & ~7;
+  for (j = 0; j < nFuncs; j++) {
+    Funcs[j].nodes += off;
+    Funcs[j].kids += off;
+    Funcs[j].refs += off;
+    Funcs[j].locals += off;
+  }
+  hdr.globals = off + Data.len;
+  hdr.formals = hdr.globals + globals.len;
+  hdr.funcs = hdr.formals + formals.len;
+  hdr.strings = hdr.funcs + nFuncs * sizeof(astfunc);
+  hdr.stringsize = Pool.len;
+  hdr.filesize = hdr.strings + Pool.len;
+
+  ok = false;
+  if ((fp = fopen(path, "w")) != NULL) {
+    fwrite(&hdr, sizeof(hdr), 1, fp);
+    fwrite("\0\0\0\0\0\0\0", 1, off - sizeof(hdr), fp);
+    fwrite(Data.buf, 1, Data.len, fp);
+    fwrite(globals.buf, 1, globals.len, fp);
+    fwrite(formals.buf, 1, formals.len, fp);
+    fwrite(Funcs, sizeof(astfunc), nFuncs, fp);
+    fwrite(Pool.buf, 1, Pool.len, fp);
+    ok = (ferror(fp) == 0);
+    ok = (fclose(fp) == 0 && ok);
+  }
+  if (!ok) {
+    fprintf(errfp, "%s: %s\n", path, strerror(errno));
+  }
+
+  free(globals.buf);
+  free(formals.buf);
+  AstDiscard();
+  return ok;
+}
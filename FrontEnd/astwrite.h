@@ -0,0 +1,26 @@
+/*
+ * astwrite.h -- writing the syntax trees and symbol tables of a program
+ * to an AST file (see astfile.h) for -fdump-ast.
+ */
+
+#ifndef _ASTWRITE_H_
+#define _ASTWRITE_H_
+
+#include "astfile.h"
+
+extern bool ast_dump;       /* set from the command line */
+
+/*
+ * The tree of one function, captured by AstCapture() on whatever thread
+ * processed it; AstEmit() adds it to the file on the compiling thread.
+ */
+struct astblob;
+
+struct astblob *AstCapture(symtabnode *fn, tnode *body);
+void AstFree(struct astblob *blob);
+void AstEmit(struct astblob *blob);
+bool AstFinish(char *path);
+void AstSymRecord(astsym *asp, symtabnode *stptr, uint32_t name);
+void AstDiscard(void);
+
+#endif  /* _ASTWRITE_H_ */
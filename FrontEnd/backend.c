@@ -0,0 +1,272 @@
+/*
+ * backend.c -- processing function bodies on a pool of threads.
+ *
+ * Normally the parser calls process_syntax_tree() for each function as
+ * soon as its body has been parsed, and goes on once it returns.  With
+ * backend_threads > 0, BackendSubmit() instead detaches the syntax tree
+ * of the function (SynTreeDetach()) and the region holding its local
+ * symbols (RegionDetach()) from the parser, and puts the function on a
+ * bounded queue served by backend_threads worker threads, so that the
+ * parser can go on with the next function while this one is processed.
+ *
+ * A worker writes the output for a function to a buffer of its own.  The
+ * parser's thread writes these buffers out in the order the functions
+ * were submitted, and only then gives the tree storage and the chunks of
+ * the local symbols back for reuse; so the output is the same as when
+ * the functions are processed one at a time.  The output for a function
+ * may depend on the functions before it only through the node counts,
+ * which the parser keeps per function as it builds the tree (see
+ * FnNodeCount) and which are added up in order.
+ */
+
+#include <pthread.h>
+#include "global.h"
+#include "symbol-table.h"
+#include "syntax-tree.h"
+#include "backend.h"
+#include "astwrite.h"
+#include "output.h"
+
+extern void process_syntax_tree(symtabnode *fn_name, tnode *fn_body);
+extern void walk_syntax_tree(symtabnode *fn_name, tnode *fn_body);
+extern void add_node_counts(symtabnode *fn, int *counts);
+
+#define BE_QUEUESZ  16      /* max. no. of functions submitted but not written out */
+
+typedef struct {
+  symtabnode *fn;           /* the function: a global, so it stays around */
+  tnode *body;              /* its body, in the storage trees */
+  treestore *trees;
+  struct rchunk *locals;    /* the chunks holding its local symbols */
+  char *text;               /* its output */
+  size_t textlen;
+  int counts[NNODECOUNTS];  /* its node counts */
+  struct astblob *ast;      /* its tree, for -fdump-ast */
+  bool done;
+} fnjob;
+
+/*
+ * Jobs are taken from the queue in three places: the oldest job not yet
+ * written out is jobs[head % BE_QUEUESZ], the next job for a worker is
+ * jobs[next % BE_QUEUESZ], and the next free slot is jobs[tail %
+ * BE_QUEUESZ]; head <= next <= tail <= head + BE_QUEUESZ.
+ */
+struct backend {
+  fnjob jobs[BE_QUEUESZ];
+  unsigned head, next, tail;
+  bool finished;            /* no more jobs will be submitted */
+  pthread_mutex_t lock;
+  pthread_cond_t work;      /* signalled when a job is submitted */
+  pthread_cond_t done;      /* signalled when a job is done */
+  FILE *errfp;
+  pthread_t *tids;
+  int nthreads;
+};
+
+int backend_threads = 0;    /* set from the command line, for all compilations */
+THREAD_LOCAL void (*FunctionSink)(symtabnode *fn, tnode *body);
+
+static THREAD_LOCAL struct backend *Backend;
+
+/*
+ * BackendWorker(arg) -- process the jobs of the back end arg until it is
+ * finished.  The tree of each job is attached to this thread while it
+ * is walked, and output goes to the job's buffer.
+ */
+static void *BackendWorker(void *arg)
+{
+  struct backend *be = arg;
+  fnjob *jp;
+
+  errfp = be->errfp;
+
+  pthread_mutex_lock(&be->lock);
+  for (;;) {
+    while (be->next == be->tail && !be->finished) {
+      pthread_cond_wait(&be->work, &be->lock);
+    }
+    if (be->next == be->tail) {
+      break;
+    }
+    jp = &be->jobs[be->next++ % BE_QUEUESZ];
+    pthread_mutex_unlock(&be->lock);
+
+    OutCapture();
+    SynTreeAttach(jp->trees);
+    walk_syntax_tree(jp->fn, jp->body);
+    jp->ast = AstCapture(jp->fn, jp->body);
+    SynTreeAttach(NULL);
+    jp->text = OutCaptured(&jp->textlen);
+
+    pthread_mutex_lock(&be->lock);
+    jp->done = true;
+    pthread_cond_broadcast(&be->done);
+  }
+  pthread_mutex_unlock(&be->lock);
+
+  return NULL;
+}
+
+/*
+ * BackendEmit(fn, text, len, counts, ast) -- write out the len bytes of
+ * output text of the function fn, processed elsewhere, followed by the
+ * node counts up to and including fn, given the counts for fn alone; and
+ * add its captured tree ast, if any, to the AST file.
+ */
+void BackendEmit(symtabnode *fn, char *text, size_t len, int *counts,
+		 struct astblob *ast)
+{
+  OutText(text, len);
+  add_node_counts(fn, counts);
+  AstEmit(ast);
+}
+
+/*
+ * WriteOut(jp) -- write out the output of the finished job jp, and give
+ * its storage back.
+ */
+static void WriteOut(fnjob *jp)
+{
+  BackendEmit(jp->fn, jp->text, jp->textlen, jp->counts, jp->ast);
+  free(jp->text);
+  jp->text = NULL;
+  jp->ast = NULL;
+
+  SynTreeRelease(jp->trees);
+  RegionReclaim(RGN_FUNCTION, jp->locals);
+}
+
+/*
+ * Retire(be, n) -- write out the finished jobs at the head of the queue
+ * of be, in order, waiting for them to finish if need be until at most
+ * n jobs are left in the queue.
+ */
+static void Retire(struct backend *be, unsigned n)
+{
+  fnjob *jp;
+
+  pthread_mutex_lock(&be->lock);
+  while (be->head != be->tail) {
+    jp = &be->jobs[be->head % BE_QUEUESZ];
+    if (!jp->done) {
+      if (be->tail - be->head <= n) {
+	break;
+      }
+      pthread_cond_wait(&be->done, &be->lock);
+      continue;
+    }
+    /*
+     * Only this thread fills slots, so the slot stays put while it is
+     * written out without the lock.
+     */
+    be->head++;
+    pthread_mutex_unlock(&be->lock);
+    WriteOut(jp);
+    pthread_mutex_lock(&be->lock);
+  }
+  pthread_mutex_unlock(&be->lock);
+}
+
+/*
+ * BackendStart() -- start the worker threads for the current
+ * compilation, if backend_threads says so.
+ */
+void BackendStart(void)
+{
+  struct backend *be;
+  int i;
+
+  if (backend_threads <= 0) {
+    return;
+  }
+
+  be = zalloc(sizeof(struct backend));
+  pthread_mutex_init(&be->lock, NULL);
+  pthread_cond_init(&be->work, NULL);
+  pthread_cond_init(&be->done, NULL);
+  be->errfp = errfp;
+  be->nthreads = backend_threads;
+  be->tids = zalloc(be->nthreads * sizeof(pthread_t));
+  for (i = 0; i < be->nthreads; i++) {
+    if (pthread_create(&be->tids[i], NULL, BackendWorker, be) != 0) {
+      fprintf(stderr, "compile: can't create back end thread\n");
+      abort();
+    }
+  }
+
+  Backend = be;
+}
+
+/*
+ * BackendSubmit(fn, body) -- process the function fn with body body:
+ * right away if there are no worker threads, otherwise by queueing it
+ * for them.  In the latter case the tree and the local symbols of the
+ * function are detached from the parser, which must call CleanupFnInfo()
+ * next as usual.  If FunctionSink is set, just pass the function to it.
+ */
+void BackendSubmit(symtabnode *fn, tnode *body)
+{
+  struct backend *be = Backend;
+  fnjob *jp;
+
+  if (FunctionSink != NULL) {
+    (*FunctionSink)(fn, body);
+    return;
+  }
+  if (be == NULL) {
+    process_syntax_tree(fn, body);
+    AstEmit(AstCapture(fn, body));
+    return;
+  }
+
+  /*
+   * Make room in the queue.  This can't write out the job being
+   * submitted, whose local symbols are still in the Local table until
+   * CleanupFnInfo().
+   */
+  Retire(be, BE_QUEUESZ - 1);
+
+  jp = &be->jobs[be->tail % BE_QUEUESZ];
+  jp->fn = fn;
+  jp->body = body;
+  memcpy(jp->counts, FnNodeCount, sizeof(jp->counts));
+  jp->trees = SynTreeDetach();
+  jp->locals = RegionDetach(RGN_FUNCTION);
+  jp->done = false;
+
+  pthread_mutex_lock(&be->lock);
+  be->tail++;
+  pthread_cond_signal(&be->work);
+  pthread_mutex_unlock(&be->lock);
+}
+
+/*
+ * BackendFinish() -- wait for all the submitted functions, write out
+ * their output, and stop the worker threads.
+ */
+void BackendFinish(void)
+{
+  struct backend *be = Backend;
+  int i;
+
+  if (be == NULL) {
+    return;
+  }
+
+  Retire(be, 0);
+
+  pthread_mutex_lock(&be->lock);
+  be->finished = true;
+  pthread_cond_broadcast(&be->work);
+  pthread_mutex_unlock(&be->lock);
+  for (i = 0; i < be->nthreads; i++) {
+    pthread_join(be->tids[i], NULL);
+  }
+
+  pthread_mutex_destroy(&be->lock);
+  pthread_cond_destroy(&be->work);
+  pthread_cond_destroy(&be->done);
+  free(be->tids);
+  free(be);
+  Backend = NULL;
+}
@@ -0,0 +1,24 @@
+/*
+ * backend.h -- processing function bodies on a pool of threads while
+ * the parser goes on with the rest of the file.
+ */
+
+#ifndef _BACKEND_H_
+#define _BACKEND_H_
+
+extern int backend_threads;   /* 0: process each function in the parser */
+
+/*
+ * If set, BackendSubmit() passes each function to this instead of
+ * processing it (see split.c).
+ */
+extern THREAD_LOCAL void (*FunctionSink)(symtabnode *fn, tnode *body);
+
+void BackendStart(void);
+void BackendSubmit(symtabnode *fn, tnode *body);
+void BackendFinish(void);
+struct astblob;
+void BackendEmit(symtabnode *fn, char *text, size_t len, int *counts,
+		 struct astblob *ast);
+
+#endif  /* _BACKEND_H_ */
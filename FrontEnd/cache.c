@@ -0,0 +1,355 @@
+/*
+ * cache.c -- an on-disk cache of the output for function definitions.
+ *
+ * With -fcache=DIR, the output of each function definition (the text
+ * written by walk_syntax_tree() and its node counts) is kept in a file
+ * in DIR named after a hash of everything it depends on: the tokens of
+ * the definition, and the types of the globals its identifiers refer to
+ * (see HashDef() in split.c).  A later compilation that finds a
+ * definition's entry uses it instead of parsing and processing the
+ * definition again.  Only definitions that compile without errors are
+ * stored, so the line numbers in error messages never come into it.
+ *
+ * The cache is kept under cache_limit bytes by removing the entries
+ * that were least recently used, going by their modification times;
+ * a hit updates the time of its entry.  Entries are written to a
+ * temporary file and renamed into place, so several compilations can
+ * share a cache.  A compilation that dies while writing one leaves its
+ * temporary file behind; CacheTrim() removes those once they are old.
+ */
+
+#include <errno.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "global.h"
+#include "symbol-table.h"
+#include "syntax-tree.h"
+#include "cache.h"
+
+/*
+ * Bump CACHE_VERSION whenever the output for a function changes, so that
+ * old entries are no longer found.
+ */
+#define CACHE_VERSION  4
+#define CACHE_MAGIC    "C--f"
+
+/*
+ * A temporary file that has not been renamed into place after TMP_AGE
+ * seconds was left by a compilation that did not finish.
+ */
+#define TMP_AGE  60
+
+char *cache_dir = NULL;                 /* set from the command line */
+long cache_limit = 64L*1024*1024;
+
+/*
+ * The header of an entry; the text follows it.
+ */
+typedef struct {
+  char magic[4];
+  uint32_t version;
+  cachekey key;
+  uint32_t textlen;
+  int32_t counts[NNODECOUNTS];
+} entryhdr;
+
+/*********************************************************************
+ *                                                                   *
+ *                               KEYS                                *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * The two halves of a key are a 64-bit FNV-1a hash and a hash that
+ * mixes in each byte with a multiply and rotate, so that the halves
+ * are not related.
+ */
+#define FNV_PRIME  0x100000001b3ULL
+
+/*
+ * CacheKeyInit(key) -- start a key; it covers the version and the
+ * build and command-line options that affect output.
+ */
+void CacheKeyInit(cachekey *key)
+{
+  int version = CACHE_VERSION;
+#ifdef DEBUG
+  int debug = 1;
+#else
+  int debug = 0;
+#endif
+
+  key->h[0] = 0xcbf29ce484222325ULL;
+  key->h[1] = 0x9e3779b97f4a7c15ULL;
+  CacheKeyAdd(key, &version, sizeof(version));
+  CacheKeyAdd(key, &debug, sizeof(debug));
+  CacheKeyAdd(key, &share_exprs, sizeof(share_exprs));
+}
+
+/*
+ * CacheKeyAdd(key, p, n) -- add the n bytes at p to the key.
+ */
+void CacheKeyAdd(cachekey *key, void *p, size_t n)
+{
+  unsigned char *s = p;
+  uint64_t a = key->h[0], b = key->h[1];
+
+  while (n-- > 0) {
+    a = (a ^ *s) * FNV_PRIME;
+    b = (b + *s++ + 1) * 0xff51afd7ed558ccdULL;
+    b = (b << 31) | (b >> 33);
+  }
+
+  key->h[0] = a;
+  key->h[1] = b;
+}
+
+/*
+ * CacheKeySymbol(key, stptr) -- add the type of the global stptr, or the
+ * fact that there is none if it is NULL, to the key.
+ */
+void CacheKeySymbol(cachekey *key, symtabnode *stptr)
+{
+  int sig[6];
+  symtabnode *formal;
+
+  memset(sig, 0, sizeof(sig));
+  if (stptr != NULL) {
+    sig[0] = 1;
+    sig[1] = stptr->type;
+    sig[2] = stptr->elt_type;
+    sig[3] = stptr->num_elts;
+    sig[4] = stptr->ret_type;
+    sig[5] = stptr->is_extern;
+  }
+  CacheKeyAdd(key, sig, sizeof(sig));
+
+  if (stptr != NULL && stptr->type == t_Func) {
+    for (formal = stptr->formals; formal != NULL; formal = formal->next) {
+      sig[0] = formal->type;
+      sig[1] = formal->elt_type;
+      CacheKeyAdd(key, sig, 2 * sizeof(int));
+    }
+    sig[0] = -1;
+    CacheKeyAdd(key, sig, sizeof(int));
+  }
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                             ENTRIES                               *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * EntryPath(key) -- return the name of the file for key, in a buffer
+ * from malloc.
+ */
+static char *EntryPath(cachekey *key)
+{
+  char *path = zalloc(strlen(cache_dir) + 40);
+
+  sprintf(path, "%s/%016llx%016llx", cache_dir,
+	  (unsigned long long) key->h[0], (unsigned long long) key->h[1]);
+  return path;
+}
+
+/*
+ * CacheOpen() -- make sure the cache directory exists.  Returns false,
+ * with a message on stderr, if it can't be created.
+ */
+bool CacheOpen(void)
+{
+  struct stat st;
+
+  if (mkdir(cache_dir, 0777) < 0 && errno != EEXIST) {
+    fprintf(stderr, "compile: %s: %s\n", cache_dir, strerror(errno));
+    return false;
+  }
+  if (stat(cache_dir, &st) < 0 || !S_ISDIR(st.st_mode)) {
+    fprintf(stderr, "compile: %s: not a directory\n", cache_dir);
+    return false;
+  }
+  return true;
+}
+
+/*
+ * CacheLookup(key, text, textlen, counts) -- look for the entry for
+ * key.  If it is there, return true, with its text in a buffer from
+ * malloc in *text and *textlen and its node counts in counts.
+ */
+bool CacheLookup(cachekey *key, char **text, size_t *textlen, int *counts)
+{
+  char *path = EntryPath(key), *buf;
+  entryhdr hdr;
+  struct stat st;
+  int fd, i;
+  bool ok = false;
+
+  if ((fd = open(path, O_RDONLY)) >= 0) {
+    if (fstat(fd, &st) == 0
+	&& read(fd, &hdr, sizeof(hdr)) == sizeof(hdr)
+	&& memcmp(hdr.magic, CACHE_MAGIC, 4) == 0
+	&& hdr.version == CACHE_VERSION
+	&& memcmp(&hdr.key, key, sizeof(cachekey)) == 0
+	&& st.st_size == (off_t) (sizeof(hdr) + hdr.textlen)) {
+      if ((buf = malloc(hdr.textlen + 1)) == NULL) {
+	fprintf(stderr, "Not enough memory\n");
+	abort();
+      }
+      if (read(fd, buf, hdr.textlen) == (ssize_t) hdr.textlen) {
+	*text = buf;
+	*textlen = hdr.textlen;
+	for (i = 0; i < NNODECOUNTS; i++) {
+	  counts[i] = hdr.counts[i];
+	}
+	futimens(fd, NULL);       /* recently used */
+	ok = true;
+      }
+      else {
+	free(buf);
+      }
+    }
+    close(fd);
+  }
+  free(path);
+
+  CountEvent(ok ? CNT_CACHE_HITS : CNT_CACHE_MISSES, 1);
+  return ok;
+}
+
+/*
+ * CacheStore(key, text, textlen, counts) -- make an entry for key with
+ * the output text of textlen bytes and the node counts.  Failing to
+ * write it is not an error.
+ */
+void CacheStore(cachekey *key, char *text, size_t textlen, int *counts)
+{
+  char *path = EntryPath(key), *tmp;
+  entryhdr hdr;
+  int fd, i;
+
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, CACHE_MAGIC, 4);
+  hdr.version = CACHE_VERSION;
+  hdr.key = *key;
+  hdr.textlen = textlen;
+  for (i = 0; i < NNODECOUNTS; i++) {
+    hdr.counts[i] = counts[i];
+  }
+
+  tmp = zalloc(strlen(cache_dir) + 16);
+  sprintf(tmp, "%s/.tmpXXXXXX", cache_dir);
+  if ((fd = mkstemp(tmp)) >= 0) {
+    if (write(fd, &hdr, sizeof(hdr)) == sizeof(hdr)
+	&& write(fd, text, textlen) == (ssize_t) textlen
+	&& close(fd) == 0) {
+      if (rename(tmp, path) < 0) {
+	unlink(tmp);
+      }
+    }
+    else {
+      close(fd);
+      unlink(tmp);
+    }
+  }
+  free(tmp);
+  free(path);
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                             EVICTION                              *
+ *                                                                   *
+ *********************************************************************/
+
+typedef struct {
+  char *name;
+  off_t size;
+  struct timespec mtime;
+} direntry;
+
+static int OlderFirst(const void *a, const void *b)
+{
+  const direntry *x = a, *y = b;
+
+  if (x->mtime.tv_sec != y->mtime.tv_sec) {
+    return (x->mtime.tv_sec < y->mtime.tv_sec ? -1 : 1);
+  }
+  if (x->mtime.tv_nsec != y->mtime.tv_nsec) {
+    return (x->mtime.tv_nsec < y->mtime.tv_nsec ? -1 : 1);
+  }
+  return 0;
+}
+
+/*
+ * CacheTrim() -- if the entries in the cache take up more than
+ * cache_limit bytes, remove the least recently used ones until they
+ * don't.  Also remove temporary files older than TMP_AGE seconds.
+ */
+void CacheTrim(void)
+{
+  DIR *dir;
+  struct dirent *de;
+  struct stat st;
+  direntry *ents = NULL;
+  int n = 0, max = 0, i;
+  long total = 0;
+  char *path;
+  time_t now = time(NULL);
+
+  if ((dir = opendir(cache_dir)) == NULL) {
+    return;
+  }
+  path = zalloc(strlen(cache_dir) + 40);
+  while ((de = readdir(dir)) != NULL) {
+    if (strncmp(de->d_name, ".tmp", 4) == 0 && strlen(de->d_name) < 32) {
+      sprintf(path, "%s/%s", cache_dir, de->d_name);
+      if (stat(path, &st) == 0 && S_ISREG(st.st_mode)
+	  && now - st.st_mtime > TMP_AGE) {
+	unlink(path);
+      }
+      continue;
+    }
+    if (strlen(de->d_name) != 32) {
+      continue;
+    }
+    sprintf(path, "%s/%s", cache_dir, de->d_name);
+    if (stat(path, &st) < 0 || !S_ISREG(st.st_mode)) {
+      continue;
+    }
+    if (n >= max) {
+      max = (max == 0 ? 1024 : 2 * max);
+      if ((ents = realloc(ents, max * sizeof(direntry))) == NULL) {
+	fprintf(stderr, "Not enough memory\n");
+	abort();
+      }
+    }
+    ents[n].name = strdup(de->d_name);
+    ents[n].size = st.st_size;
+    ents[n].mtime = st.st_mtim;
+    total += st.st_size;
+    n++;
+  }
+  closedir(dir);
+
+  if (total > cache_limit) {
+    qsort(ents, n, sizeof(direntry), OlderFirst);
+    for (i = 0; i < n && total > cache_limit; i++) {
+      sprintf(path, "%s/%s", cache_dir, ents[i].name);
+      if (unlink(path) == 0) {
+	total -= ents[i].size;
+	CountEvent(CNT_CACHE_EVICTS, 1);
+      }
+    }
+  }
+
+  for (i = 0; i < n; i++) {
+    free(ents[i].name);
+  }
+  free(ents);
+  free(path);
+}
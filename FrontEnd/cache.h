@@ -0,0 +1,30 @@
+/*
+ * cache.h -- an on-disk cache of the output for function definitions.
+ */
+
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+#include <stdint.h>
+
+extern char *cache_dir;     /* NULL: no cache */
+extern long cache_limit;    /* max. size of the cache in bytes */
+
+/*
+ * The key of a cache entry: a 128-bit hash of everything the output
+ * for a function depends on.
+ */
+typedef struct {
+  uint64_t h[2];
+} cachekey;
+
+void CacheKeyInit(cachekey *key);
+void CacheKeyAdd(cachekey *key, void *p, size_t n);
+void CacheKeySymbol(cachekey *key, symtabnode *stptr);
+
+bool CacheOpen(void);
+bool CacheLookup(cachekey *key, char **text, size_t *textlen, int *counts);
+void CacheStore(cachekey *key, char *text, size_t textlen, int *counts);
+void CacheTrim(void);
+
+#endif  /* _CACHE_H_ */
@@ -0,0 +1,710 @@
+/*
+ * cmmgen.c -- generate C-- programs for benchmarking the front end.
+ *
+ * Usage: cmmgen [-f funcs] [-s stmts] [-d depth] [-g globals] [-l locals]
+ *               [-a array%] [-c comment%] [-r seed]
+ *
+ * Writes to stdout a program without errors with the given number of
+ * function definitions (default 100), statements at the top level of
+ * each body (20), depth of expressions (3), global variables (50) and
+ * locals per function (8); array% of the variables and formals are
+ * arrays (20), and comment% of the statements and declarations have a
+ * comment before them (10).  The same options and seed (1) always give
+ * the same program, whatever the C library.
+ *
+ * The programs use every production of parser.y but the error ones:
+ * globals, prototypes (single, chained with commas and extern), formals
+ * that are arrays, locals of blocks, each kind of statement with optional
+ * parts present and absent, each operator, calls in expressions and as
+ * statements, and the three kinds of constants.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAXPARMS    4
+#define MAXNEST     3      /* nesting of compound statements */
+#define MAXBLOCKVARS 3     /* locals declared at the start of a block */
+
+enum { T_INT, T_CHAR, T_VOID };
+static char *TypeName[] = {"int", "char", "void"};
+
+typedef struct {
+  char name[16];
+  int type;        /* T_INT or T_CHAR; the element type of arrays */
+  bool array;
+  int size;        /* number of elements; 0 for a formal */
+} var;
+
+typedef struct {
+  char name[16];
+  int ret;
+  int nparms;
+  var parms[MAXPARMS];
+  bool proto;      /* declared by a prototype before the definitions */
+  bool is_extern;
+} func;
+
+static int nFuncs = 100, nStmts = 20, exprDepth = 3, nGlobals = 50;
+static int nLocals = 8, arrayPct = 20, commentPct = 10;
+
+static func *Funcs;
+static int nAll;           /* functions, then the externs */
+
+/*
+ * Globals that every program has, so that there is always a variable
+ * to use, and an array of each type to pass for a formal that is one.
+ */
+static var Extra[] = {
+  {"gi", T_INT, false, 0}, {"ga", T_INT, true, 16}, {"gs", T_CHAR, true, 64}
+};
+#define NEXTRA ((int) (sizeof(Extra) / sizeof(Extra[0])))
+
+/*
+ * The variables visible in the function being generated: the globals,
+ * then the formals, the locals and those of the enclosing blocks.
+ */
+static var *Vis;
+static int nVis;
+static int curFn;          /* the function being generated */
+static int nBlockVars;     /* for unique names of locals of blocks */
+static int indent;
+
+/*********************************************************************
+ *                                                                   *
+ *                          RANDOM NUMBERS                           *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * A xorshift generator of our own, so that the output depends only on
+ * the seed.
+ */
+static unsigned long long RandState;
+
+static unsigned Rand(unsigned n)
+{
+  RandState ^= RandState << 13;
+  RandState ^= RandState >> 7;
+  RandState ^= RandState << 17;
+  return (unsigned) ((RandState >> 11) % n);
+}
+
+static bool Chance(int pct)
+{
+  return (int) Rand(100) < pct;
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                              OUTPUT                               *
+ *                                                                   *
+ *********************************************************************/
+
+static char *Words[] = {
+  "compute", "the", "next", "value", "of", "index", "check", "bounds",
+  "update", "total", "loop", "until", "done", "result", "temporary", "sum",
+  "scale", "count", "entries", "table", "before", "after", "each", "step"
+};
+#define NWORDS (sizeof(Words) / sizeof(Words[0]))
+
+static void *Alloc(size_t n)
+{
+  void *p = calloc(1, n);
+
+  if (p == NULL) {
+    fprintf(stderr, "Not enough memory\n");
+    abort();
+  }
+  return p;
+}
+
+static void Indent(void)
+{
+  int i;
+
+  for (i = 0; i < indent; i++) {
+    fputs("  ", stdout);
+  }
+}
+
+/*
+ * Comment() -- with probability commentPct, write a comment of a few
+ * words on a line of its own, sometimes over several lines.
+ */
+static void Comment(void)
+{
+  int i, n;
+
+  if (!Chance(commentPct)) return;
+  Indent();
+  fputs("/*", stdout);
+  n = 2 + Rand(8);
+  for (i = 0; i < n; i++) {
+    printf(" %s", Words[Rand(NWORDS)]);
+  }
+  if (Chance(25)) {
+    putchar('\n');
+    Indent();
+    printf(" * %s %s\n", Words[Rand(NWORDS)], Words[Rand(NWORDS)]);
+    Indent();
+    fputs(" */\n", stdout);
+  }
+  else {
+    fputs(" */\n", stdout);
+  }
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                              SYMBOLS                              *
+ *                                                                   *
+ *********************************************************************/
+
+static void MakeVar(var *v, char *prefix, int n, bool formal)
+{
+  sprintf(v->name, "%s%d", prefix, n);
+  v->type = Chance(70) ? T_INT : T_CHAR;
+  v->array = Chance(arrayPct);
+  v->size = (v->array && !formal ? 1 + Rand(100) : 0);
+}
+
+/*
+ * PickVar(array, type) -- a visible variable that is an array (or not),
+ * of the given type (any type if type < 0), or NULL if there is none.
+ * The formals and locals are picked as often as all the globals.
+ */
+static var *PickVar(bool array, int type)
+{
+  int i, start, lo;
+
+  lo = (nVis > nGlobals && Chance(50) ? nGlobals : 0);
+  for (;;) {
+    start = lo + Rand(nVis - lo);
+    for (i = start; ; ) {
+      if (Vis[i].array == array && (type < 0 || Vis[i].type == type)) {
+	return &Vis[i];
+      }
+      if (++i == nVis) i = lo;
+      if (i == start) break;
+    }
+    if (lo == 0) return NULL;
+    lo = 0;
+  }
+}
+
+/*
+ * Callable(f) -- can function f be called from the current one?  Only
+ * if it was declared by a prototype or defined before it.
+ */
+static bool Callable(func *f)
+{
+  return f->proto || f - Funcs <= curFn;
+}
+
+/*
+ * PickFunc(isVoid) -- a function that can be called, returning void
+ * or not, or NULL if there is none.
+ */
+static func *PickFunc(bool isVoid)
+{
+  int i, start = Rand(nAll);
+
+  for (i = start; ; ) {
+    if (Callable(&Funcs[i]) && (Funcs[i].ret == T_VOID) == isVoid) {
+      return &Funcs[i];
+    }
+    if (++i == nAll) i = 0;
+    if (i == start) return NULL;
+  }
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                            EXPRESSIONS                            *
+ *                                                                   *
+ *********************************************************************/
+
+static void Expr(int depth);
+
+static void Leaf(void)
+{
+  var *v;
+
+  switch (Rand(6)) {
+  case 0:
+    printf("%u", Rand(1000));
+    return;
+  case 1:
+    switch (Rand(8)) {
+    case 0:  fputs("'\\n'", stdout); break;
+    case 1:  fputs("'\\0'", stdout); break;
+    default: printf("'%c'", 'a' + Rand(26)); break;
+    }
+    return;
+  case 2:
+    if ((v = PickVar(true, -1)) != NULL) {
+      printf("%s[%u]", v->name, (v->size > 0 ? Rand(v->size) : 0));
+      return;
+    }
+    /* FALLTHROUGH */
+  default:
+    printf("%s", PickVar(false, -1)->name);
+    return;
+  }
+}
+
+/*
+ * Call(f, depth) -- a call of f with arguments of the right types.
+ */
+static void Call(func *f, int depth)
+{
+  var *v;
+  int i;
+
+  printf("%s(", f->name);
+  for (i = 0; i < f->nparms; i++) {
+    if (i > 0) fputs(", ", stdout);
+    if (!f->parms[i].array) {
+      Expr(depth);
+    }
+    else if (f->parms[i].type == T_CHAR && Chance(30)) {
+      printf("\"%s %s\"", Words[Rand(NWORDS)], Words[Rand(NWORDS)]);
+    }
+    else {
+      v = PickVar(true, f->parms[i].type);
+      printf("%s", v->name);
+    }
+  }
+  putchar(')');
+}
+
+/*
+ * Expr(depth) -- an int or char expression with up to depth levels of
+ * operators above the leaves.  Divisors are never constant 0, so that
+ * the programs stay free of errors even if constant expressions are
+ * folded.
+ */
+static void Expr(int depth)
+{
+  static char *ops[] = {" + ", " - ", " * ", " / "};
+  func *f;
+  var *v;
+  int op;
+
+  if (depth <= 0 || Chance(20)) {
+    Leaf();
+    return;
+  }
+  switch (Rand(8)) {
+  case 0: case 1: case 2: case 3:
+    op = Rand(4);
+    Expr(depth-1);
+    fputs(ops[op], stdout);
+    if (op == 3 && Chance(50)) {
+      printf("%u", 1 + Rand(9));
+    }
+    else if (op == 3) {
+      printf("%s", PickVar(false, -1)->name);
+    }
+    else {
+      Expr(depth-1);
+    }
+    break;
+  case 4:
+    putchar('-');
+    Expr(depth-1);
+    break;
+  case 5:
+    if ((f = PickFunc(false)) != NULL) {
+      Call(f, depth-1);
+      break;
+    }
+    /* FALLTHROUGH */
+  case 6:
+    if ((v = PickVar(true, -1)) != NULL) {
+      printf("%s[", v->name);
+      Expr(depth-1);
+      putchar(']');
+      break;
+    }
+    /* FALLTHROUGH */
+  default:
+    putchar('(');
+    Expr(depth-1);
+    putchar(')');
+    break;
+  }
+}
+
+/*
+ * BoolExpr(depth) -- a Boolean expression.
+ */
+static void BoolExpr(int depth)
+{
+  static char *relops[] = {" == ", " != ", " <= ", " >= ", " < ", " > "};
+
+  if (depth <= 1 || Chance(40)) {
+    Expr(depth-1);
+    fputs(relops[Rand(6)], stdout);
+    Expr(depth-1);
+    return;
+  }
+  switch (Rand(4)) {
+  case 0:
+    BoolExpr(depth-1);
+    fputs(" && ", stdout);
+    BoolExpr(depth-1);
+    break;
+  case 1:
+    BoolExpr(depth-1);
+    fputs(" || ", stdout);
+    BoolExpr(depth-1);
+    break;
+  case 2:
+    fputs("!(", stdout);
+    BoolExpr(depth-1);
+    putchar(')');
+    break;
+  default:
+    putchar('(');
+    BoolExpr(depth-1);
+    putchar(')');
+    break;
+  }
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                            STATEMENTS                             *
+ *                                                                   *
+ *********************************************************************/
+
+static void Stmt(int nest);
+
+static void Assignment(void)
+{
+  var *v;
+
+  if (Chance(25) && (v = PickVar(true, -1)) != NULL) {
+    printf("%s[", v->name);
+    Expr(exprDepth > 1 ? 1 : 0);
+    putchar(']');
+  }
+  else {
+    printf("%s", PickVar(false, -1)->name);
+  }
+  fputs(" = ", stdout);
+  Expr(exprDepth);
+}
+
+static void Return(void)
+{
+  if (Funcs[curFn].ret == T_VOID) {
+    fputs("return;\n", stdout);
+  }
+  else {
+    fputs("return ", stdout);
+    Expr(exprDepth);
+    fputs(";\n", stdout);
+  }
+}
+
+/*
+ * VarDecls(prefix, n, num) -- declarations of n variables named
+ * prefix<num>..., a few to a line, which become visible.
+ */
+static void VarDecls(char *prefix, int n, int num)
+{
+  var *v;
+  int i, type;
+
+  for (i = 0; i < n; ) {
+    Comment();
+    Indent();
+    type = Chance(70) ? T_INT : T_CHAR;
+    printf("%s ", TypeName[type]);
+    for (;;) {
+      v = &Vis[nVis++];
+      MakeVar(v, prefix, num + i, false);
+      v->type = type;
+      printf("%s", v->name);
+      if (v->array) printf("[%d]", v->size);
+      if (++i == n || !Chance(60)) break;
+      fputs(", ", stdout);
+    }
+    fputs(";\n", stdout);
+  }
+}
+
+/*
+ * Block(nest, n) -- a compound statement of n statements, sometimes with
+ * locals of its own.
+ */
+static void Block(int nest, int n)
+{
+  int saveVis = nVis, nv = 0;
+
+  fputs("{\n", stdout);
+  indent++;
+  if (nest > 0 && Chance(30)) {
+    nv = 1 + Rand(MAXBLOCKVARS);
+    VarDecls("b", nv, nBlockVars);
+    nBlockVars += nv;
+  }
+  while (n-- > 0) {
+    Stmt(nest);
+  }
+  indent--;
+  Indent();
+  fputs("}\n", stdout);
+  nVis = saveVis;
+}
+
+/*
+ * Stmt(nest) -- a statement, inside nest compound statements.
+ */
+static void Stmt(int nest)
+{
+  func *f;
+  int r = Rand(100);
+
+  Comment();
+  Indent();
+  if (nest >= MAXNEST && r >= 30 && r < 80) {
+    r = 0;               /* no deeper */
+  }
+
+  if (r < 30) {
+    Assignment();
+    fputs(";\n", stdout);
+  }
+  else if (r < 42) {
+    fputs("if (", stdout);
+    BoolExpr(exprDepth);
+    fputs(") ", stdout);
+    Block(nest+1, 1 + Rand(3));
+    if (Chance(50)) {
+      Indent();
+      fputs("else ", stdout);
+      if (Chance(30)) {
+	putchar('\n');
+	indent++;
+	Stmt(nest+1);
+	indent--;
+      }
+      else {
+	Block(nest+1, 1 + Rand(3));
+      }
+    }
+  }
+  else if (r < 50) {
+    fputs("while (", stdout);
+    BoolExpr(exprDepth);
+    fputs(") ", stdout);
+    Block(nest+1, 1 + Rand(3));
+  }
+  else if (r < 58) {
+    fputs("for (", stdout);
+    if (Chance(85)) Assignment();
+    fputs("; ", stdout);
+    if (Chance(85)) BoolExpr(exprDepth);
+    fputs("; ", stdout);
+    if (Chance(85)) Assignment();
+    fputs(") ", stdout);
+    if (Chance(20)) {
+      putchar('\n');
+      indent++;
+      Stmt(nest+1);
+      indent--;
+    }
+    else {
+      Block(nest+1, 1 + Rand(3));
+    }
+  }
+  else if (r < 64) {
+    Block(nest+1, 1 + Rand(4));
+  }
+  else if (r < 66) {
+    fputs(";\n", stdout);
+  }
+  else if (r < 69) {
+    Return();
+  }
+  else if (r < 80 && (f = PickFunc(true)) != NULL) {
+    Call(f, exprDepth-1);
+    fputs(";\n", stdout);
+  }
+  else {
+    Assignment();
+    fputs(";\n", stdout);
+  }
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                            DECLARATIONS                           *
+ *                                                                   *
+ *********************************************************************/
+
+static void MakeFunc(func *f, char *prefix, int n)
+{
+  int i, r = Rand(100);
+
+  sprintf(f->name, "%s%d", prefix, n);
+  f->ret = (r < 60 ? T_INT : r < 75 ? T_CHAR : T_VOID);
+  f->nparms = Rand(MAXPARMS + 1);
+  for (i = 0; i < f->nparms; i++) {
+    MakeVar(&f->parms[i], "p", i, true);
+  }
+  f->proto = Chance(75);
+}
+
+static void Parms(func *f)
+{
+  int i;
+
+  if (f->nparms == 0) {
+    fputs("void", stdout);
+  }
+  for (i = 0; i < f->nparms; i++) {
+    printf("%s%s %s%s", (i > 0 ? ", " : ""), TypeName[f->parms[i].type],
+	   f->parms[i].name, (f->parms[i].array ? "[]" : ""));
+  }
+}
+
+/*
+ * Prototypes() -- the prototypes of the externs and of the functions
+ * defined later.  Several are declared together, "int f(...), g(void);",
+ * only where parser.y gets them right: it takes the return type of each
+ * but the first from the type of the last formal before it, and the name
+ * from the last identifier before it.
+ */
+static void Prototypes(void)
+{
+  func *f;
+  int i;
+  bool chain = false;
+
+  for (i = 0; i < nAll; i++) {
+    f = &Funcs[i];
+    if (!f->proto) continue;
+    if (chain && !f->is_extern && f->ret == T_INT && f->nparms == 0) {
+      printf(", %s(void)", f->name);
+      continue;
+    }
+    if (chain) fputs(";\n", stdout);
+    Comment();
+    printf("%s%s %s(", (f->is_extern ? "extern " : ""), TypeName[f->ret], f->name);
+    Parms(f);
+    putchar(')');
+    chain = (f->ret == T_INT
+	     && (f->nparms == 0 || f->parms[f->nparms-1].type == T_INT)
+	     && Chance(50));
+    if (!chain) fputs(";\n", stdout);
+  }
+  if (chain) fputs(";\n", stdout);
+}
+
+static void Definition(int n)
+{
+  func *f = &Funcs[n];
+  int i;
+
+  curFn = n;
+  nVis = nGlobals;
+  nBlockVars = 0;
+  for (i = 0; i < f->nparms; i++) {
+    Vis[nVis++] = f->parms[i];
+  }
+
+  putchar('\n');
+  Comment();
+  printf("%s %s(", TypeName[f->ret], f->name);
+  Parms(f);
+  fputs(")\n{\n", stdout);
+  indent = 1;
+  VarDecls("l", nLocals, 0);
+  for (i = 0; i < nStmts; i++) {
+    Stmt(0);
+  }
+  if (f->ret != T_VOID || Chance(50)) {
+    Indent();
+    Return();
+  }
+  indent = 0;
+  fputs("}\n", stdout);
+}
+
+static void Usage(char *prog)
+{
+  fprintf(stderr, "Usage: %s [-f funcs] [-s stmts] [-d depth] [-g globals] "
+	  "[-l locals]\n\t[-a array%%] [-c comment%%] [-r seed]\n", prog);
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned long long seed = 1;
+  int i, nExterns;
+
+  for (i = 1; i < argc; i++) {
+    if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0'
+	|| i+1 == argc) {
+      Usage(argv[0]);
+    }
+    switch (argv[i++][1]) {
+    case 'f': nFuncs = atoi(argv[i]); break;
+    case 's': nStmts = atoi(argv[i]); break;
+    case 'd': exprDepth = atoi(argv[i]); break;
+    case 'g': nGlobals = atoi(argv[i]); break;
+    case 'l': nLocals = atoi(argv[i]); break;
+    case 'a': arrayPct = atoi(argv[i]); break;
+    case 'c': commentPct = atoi(argv[i]); break;
+    case 'r': seed = strtoull(argv[i], NULL, 10); break;
+    default:  Usage(argv[0]);
+    }
+  }
+  if (nFuncs < 1 || nStmts < 0 || exprDepth < 1 || nGlobals < 0
+      || nLocals < 0 || arrayPct < 0 || commentPct < 0) {
+    Usage(argv[0]);
+  }
+  RandState = seed * 2654435761ULL + 88172645463325252ULL;
+
+  nGlobals += NEXTRA;
+  nExterns = nFuncs / 10 + 1;
+  nAll = nFuncs + nExterns;
+  Funcs = Alloc(nAll * sizeof(func));
+  Vis = Alloc((nGlobals + MAXPARMS + nLocals + MAXNEST * MAXBLOCKVARS)
+	       * sizeof(var));
+
+  for (i = 0; i < nFuncs; i++) {
+    MakeFunc(&Funcs[i], "fn", i);
+  }
+  for (i = 0; i < nExterns; i++) {
+    MakeFunc(&Funcs[nFuncs + i], "ext", i);
+    Funcs[nFuncs + i].proto = Funcs[nFuncs + i].is_extern = true;
+  }
+
+  printf("/* generated by: cmmgen -f %d -s %d -d %d -g %d -l %d -a %d -c %d -r %llu */\n\n",
+	 nFuncs, nStmts, exprDepth, nGlobals - NEXTRA, nLocals, arrayPct,
+	 commentPct, seed);
+  nVis = 0;
+  indent = 0;
+  VarDecls("g", nGlobals - NEXTRA, 0);
+  for (i = 0; i < NEXTRA; i++) {
+    Vis[nVis++] = Extra[i];
+    printf("%s %s", TypeName[Extra[i].type], Extra[i].name);
+    if (Extra[i].array) printf("[%d]", Extra[i].size);
+    fputs(";\n", stdout);
+  }
+  putchar('\n');
+  Prototypes();
+  for (i = 0; i < nFuncs; i++) {
+    Definition(i);
+  }
+
+  return 0;
+}
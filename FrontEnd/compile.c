@@ -0,0 +1,384 @@
+/*
+ * compile.c -- compiling one translation unit.
+ *
+ * All of the state of a compilation (scanner, parser, symbol tables,
+ * memory regions, syntax trees, counters) is kept in thread-local
+ * variables, and Compile() sets it up at the start and frees it at the
+ * end.  So a thread can compile any number of files one after another,
+ * and different threads can compile different files at the same time,
+ * provided the scanner is thread-safe (see scanner_thread_safe in
+ * scanner.h).
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "global.h"
+#include "error.h"
+#include "symbol-table.h"
+#include "syntax-tree.h"
+#include "scanner.h"
+#include "backend.h"
+#include "cache.h"
+#include "split.h"
+#include "astwrite.h"
+#include "pch.h"
+#include "output.h"
+#include "compile.h"
+
+extern int yyparse();
+extern void ResetNodeCounts(void);
+extern THREAD_LOCAL int errstate;
+
+/*
+ * A prelude is what is left of compiling a file of declarations: its
+ * atoms and its Global table, which stay with the thread that compiled
+ * it.  A thread using a prelude (see CompileResident()) starts each
+ * compilation with copies of its globals.
+ */
+struct prelude {
+  struct atomtab *atoms;
+  struct globaltab *globals;
+};
+
+static THREAD_LOCAL struct prelude *Prelude;
+static THREAD_LOCAL bool Resident;    /* keep memory between compilations */
+
+/*
+ * The precompiled header given with -fpch, for all threads: compilations
+ * start with it unless their thread has a prelude of its own.
+ */
+static struct prelude *Precompiled;
+
+/*
+ * Base() -- the prelude the compilations of the calling thread start
+ * with, if any.
+ */
+static struct prelude *Base(void)
+{
+  return (Prelude != NULL ? Prelude : Precompiled);
+}
+
+/*
+ * MapInput(path, maplen, lenp) -- map the file path into memory, so
+ * that the scanner can work on it in place.  flex needs the buffer to
+ * end with two NUL bytes; these come from an anonymous mapping that the
+ * file is mapped over, so nothing is copied even when the file size is a
+ * multiple of the page size.  The mapping is private and writable since the scanner
+ * writes into the buffer, and it has to stay around until the end of the
+ * compilation because string constants in syntax trees point into it.
+ * Returns the start of the mapping, its length in *maplen and the length
+ * of the file in *lenp, or NULL if the file can't be mapped.
+ */
+static char *MapInput(char *path, size_t *maplen, size_t *lenp)
+{
+  int fd;
+  struct stat st;
+  size_t len, pagesz;
+  char *buf;
+
+  if ((fd = open(path, O_RDONLY)) < 0 || fstat(fd, &st) < 0) {
+    fprintf(errfp, "%s: %s\n", path, strerror(errno));
+    if (fd >= 0) close(fd);
+    return NULL;
+  }
+
+  len = st.st_size;
+  pagesz = sysconf(_SC_PAGESIZE);
+  *maplen = (len + 2 + pagesz - 1) & ~(pagesz - 1);
+
+  buf = mmap(NULL, *maplen, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+  if (buf == MAP_FAILED
+      || (len > 0
+	  && mmap(buf, len, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED, fd, 0) == MAP_FAILED)) {
+    fprintf(errfp, "%s: %s\n", path, strerror(errno));
+    if (buf != MAP_FAILED) munmap(buf, *maplen);
+    close(fd);
+    return NULL;
+  }
+  close(fd);
+  *lenp = len;
+
+  return buf;
+}
+
+/*
+ * InitTables() -- set up empty symbol tables for a compilation, with the
+ * globals of the prelude in use, if any.
+ */
+static void InitTables(void)
+{
+  SymTabInit(Global);
+  if (Base() != NULL) {
+    SymTabSeedGlobal(Base()->globals);
+  }
+  SymTabInit(Local);
+}
+
+/*
+ * Restart(buf, len) -- throw away all that a failed ParseSplit() did, and
+ * get ready to parse the len bytes at buf from the start.
+ */
+static void Restart(char *buf, size_t len)
+{
+  CleanupFnInfo();
+  AstDiscard();
+  SymTabFree();
+  SynTreeFree();
+  AtomTabFree();
+  RegionFree(RGN_FUNCTION);
+  RegionFree(RGN_PROGRAM);
+
+  ResetNodeCounts();
+  memset(StatCounters, 0, sizeof(StatCounters));
+  linenum = 1;
+  errstate = ORDINARY;
+  errcount = 0;
+  InitTables();
+
+  yy_scan_buffer(buf, len + 2);
+  scan_in_place = true;
+}
+
+/*
+ * DoCompile(path, buf, len, out, err, keep) -- compile the file path, or
+ * the len bytes at buf if path is NULL, or stdin if both are NULL, on
+ * the calling thread, writing output to out and error messages to err.
+ * A buffer must be followed by two NUL bytes, and is written into by the
+ * scanner.  If keep is set, the atoms and Global table are left in place
+ * for LoadPrelude().  With -fdump-ast, a file that compiles without
+ * errors gets an AST file (see astwrite.c) named after it, or a.ast for
+ * stdin.  Returns the exit status for the compilation.
+ */
+static int DoCompile(char *path, char *buf, size_t len, FILE *out, FILE *err,
+		     bool keep)
+{
+  volatile int status = 0;
+  volatile bool split;
+  size_t maplen = 0;
+  char *astpath = NULL;
+  jmp_buf env;
+
+  OutOpen(out, true);
+  errfp = err;
+  StatsStart();
+  ResetNodeCounts();
+  linenum = 1;
+  errstate = ORDINARY;
+  errcount = 0;
+
+  if (ast_dump && buf == NULL && !keep) {
+    astpath = zalloc((path != NULL ? strlen(path) : 1) + 5);
+    sprintf(astpath, "%s.ast", (path != NULL ? path : "a"));
+  }
+  if (path != NULL && (buf = MapInput(path, &maplen, &len)) == NULL) {
+    OutClose();
+    free(astpath);
+    return 1;
+  }
+  if (buf != NULL) {
+    yy_scan_buffer(buf, len + 2);
+    scan_in_place = true;
+  }
+
+  if (Base() != NULL) {
+    AtomTabImport(Base()->atoms);
+  }
+  InitTables();
+  BackendStart();
+
+  /*
+   * A fatal error in the scanner ends up here, through CompileAbort().
+   */
+  abort_env = &env;
+  if (setjmp(env) == 0) {
+    PhaseBegin(PH_PARSE);
+    /*
+     * With -fparse-threads or -fcache, try to parse the function
+     * bodies separately first; if that can't be done, start over
+     * serially.
+     */
+    if (buf == NULL || (parse_threads <= 0 && cache_dir == NULL)) {
+      split = false;
+    }
+    else if (!(split = ParseSplit(buf, len))) {
+      Restart(buf, len);
+    }
+    if (!split && yyparse() < 0) {
+      OutStr("main: syntax error\n");
+      status = 1;
+    }
+    PhaseEnd();
+  }
+  else {
+    status = -1;
+  }
+  abort_env = NULL;
+  CountEvent(CNT_LINES, linenum);
+
+  PhaseBegin(PH_PROCESS);
+  BackendFinish();
+  PhaseEnd();
+
+  if (astpath != NULL && status == 0 && errcount == 0) {
+    if (!AstFinish(astpath)) {
+      status = 1;
+    }
+  }
+  else {
+    AstDiscard();
+  }
+  free(astpath);
+
+#ifdef RGNSTATS
+  DumpRegionTotals(RGN_PROGRAM, "program");
+  DumpRegionTotals(RGN_FUNCTION, "function");
+  DumpAtomStats();
+#endif
+  PrintTimeReport();
+  OutClose();
+
+  /*
+   * Throw away whatever a syntax error may have left behind, then all
+   * the memory of the compilation; a resident thread keeps the tables,
+   * region chunks and tree storage for the next one.
+   */
+  CleanupFnInfo();
+  yylex_destroy();
+  if (maplen > 0) {
+    munmap(buf, maplen);
+  }
+  scan_in_place = false;
+  AtomTabImport(NULL);
+  if (keep) {
+    SynTreeFree();
+    RegionFree(RGN_FUNCTION);
+  }
+  else if (Resident) {
+    AtomTabFree();
+    SynTreeReset();
+    RegionReset(RGN_FUNCTION);
+    RegionReset(RGN_PROGRAM);
+  }
+  else {
+    SymTabFree();
+    SynTreeFree();
+    AtomTabFree();
+    RegionFree(RGN_FUNCTION);
+    RegionFree(RGN_PROGRAM);
+  }
+
+  return status;
+}
+
+/*
+ * Compile(path, out, err) -- compile the file path, or stdin if path is
+ * NULL, on the calling thread, writing output to out and error messages
+ * to err.  Returns the exit status for the compilation.
+ */
+int Compile(char *path, FILE *out, FILE *err)
+{
+  return DoCompile(path, NULL, 0, out, err, false);
+}
+
+/*
+ * CompileBuffer(buf, len, out, err) -- like Compile(), for the len bytes
+ * at buf, which must be followed by two NUL bytes.  The scanner writes
+ * into the buffer.
+ */
+int CompileBuffer(char *buf, size_t len, FILE *out, FILE *err)
+{
+  return DoCompile(NULL, buf, len, out, err, false);
+}
+
+/*
+ * LoadPrelude(path, err) -- compile the file path, normally a list of
+ * prototypes and global declarations, and keep its atoms and globals on
+ * the calling thread, for other threads to start their compilations
+ * with.  Its output is thrown away.  The calling thread must not compile
+ * anything else while the prelude is in use.  Returns NULL, with error
+ * messages written to err, if the file does not compile cleanly.
+ */
+struct prelude *LoadPrelude(char *path, FILE *err)
+{
+  struct prelude *p;
+  FILE *out;
+
+  if ((out = fopen("/dev/null", "w")) == NULL) {
+    fprintf(err, "/dev/null: %s\n", strerror(errno));
+    return NULL;
+  }
+  if (DoCompile(path, NULL, 0, out, err, true) != 0 || errcount > 0) {
+    fclose(out);
+    SymTabFree();
+    AtomTabFree();
+    RegionFree(RGN_PROGRAM);
+    return NULL;
+  }
+  fclose(out);
+
+  /*
+   * The atoms of the precompiled header, if any, are searched after
+   * those of the prelude, since its globals came from there.
+   */
+  p = zalloc(sizeof(struct prelude));
+  AtomTabImport(Base() != NULL ? Base()->atoms : NULL);
+  p->atoms = AtomTabExport();
+  p->globals = SymTabExportGlobal();
+  AtomTabImport(NULL);
+
+  return p;
+}
+
+/*
+ * CompileResident(p) -- from now on, start each compilation on the
+ * calling thread with the globals of the prelude p, if not NULL, and
+ * keep the thread's memory from one compilation to the next instead of
+ * giving it back, as a server does.
+ */
+void CompileResident(struct prelude *p)
+{
+  Prelude = p;
+  Resident = true;
+}
+
+/*
+ * UsePrecompiled(path) -- load the precompiled header path (see pch.c),
+ * for all compilations on all threads from now on to start with.
+ * Returns false, with a message on stderr, if it can't be loaded.
+ */
+bool UsePrecompiled(char *path)
+{
+  struct prelude *p = zalloc(sizeof(struct prelude));
+
+  if (!PchLoad(path, &p->atoms, &p->globals)) {
+    free(p);
+    return false;
+  }
+  Precompiled = p;
+  return true;
+}
+
+/*
+ * Precompile(path, out, err) -- compile the file path, a list of
+ * prototypes and global declarations, and write its globals to the
+ * precompiled header out.  Error messages go to err.  Returns the exit
+ * status.
+ */
+int Precompile(char *path, char *out, FILE *err)
+{
+  struct prelude *p;
+  bool ok;
+
+  if ((p = LoadPrelude(path, err)) == NULL) {
+    return 1;
+  }
+  ok = PchWrite(out);
+  free(p->atoms);
+  free(p->globals);
+  free(p);
+
+  return (ok ? 0 : 1);
+}
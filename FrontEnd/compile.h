@@ -0,0 +1,17 @@
+/*
+ * compile.h -- compiling a file from start to finish.
+ */
+
+#ifndef _COMPILE_H_
+#define _COMPILE_H_
+
+int Compile(char *path, FILE *out, FILE *err);
+int CompileBuffer(char *buf, size_t len, FILE *out, FILE *err);
+
+struct prelude;
+struct prelude *LoadPrelude(char *path, FILE *err);
+void CompileResident(struct prelude *p);
+bool UsePrecompiled(char *path);
+int Precompile(char *path, char *out, FILE *err);
+
+#endif  /* _COMPILE_H_ */
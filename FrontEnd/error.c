@@ -4,9 +4,11 @@
 #include "syntax-tree.h"
 #include "y.tab.h"
 #include "error.h"
+#include "scanner.h"
 
-extern int linenum, yychar, errstate;
-extern char yytext[], *id_name;
+extern THREAD_LOCAL int errstate;
+
+THREAD_LOCAL int errcount;
 
 /*********************************************************************
  *                                                                   *
@@ -19,9 +21,26 @@ void errmsg(const char *fmt, ...)
   va_list args;
   va_start(args, fmt);
 
-  fprintf(stderr, "ERROR [line %d]: ", linenum);
-  vfprintf(stderr, fmt, args);
-  fprintf(stderr, "\n");
+  errcount++;
+  fprintf(errfp, "ERROR [line %d]: ", linenum);
+  vfprintf(errfp, fmt, args);
+  fprintf(errfp, "\n");
+
+  va_end(args);
+}
+
+/*
+ * warnmsg(fmt, ...) -- report something suspicious that is not an error,
+ * e.g. a division by a constant 0; it does not count in errcount.
+ */
+void warnmsg(const char *fmt, ...)
+{
+  va_list args;
+  va_start(args, fmt);
+
+  fprintf(errfp, "WARNING [line %d]: ", linenum);
+  vfprintf(errfp, fmt, args);
+  fprintf(errfp, "\n");
 
   va_end(args);
 }
@@ -36,58 +55,58 @@ void report(int tok_type)
 {
   switch (tok_type) {
   case  ID :
-    fprintf(stderr, "identifier \"%s\"\n", id_name); 
+    fprintf(errfp, "identifier \"%s\"\n", id_name); 
     break;
   case  INTCON :
-    fprintf(stderr, "integer constant \"%s\"\n", yytext); 
+    fprintf(errfp, "integer constant \"%s\"\n", ScanText()); 
     break;
   case  CHARCON :
-    fprintf(stderr, "character constant \"%s\"\n", yytext); 
+    fprintf(errfp, "character constant \"%s\"\n", ScanText()); 
     break;
   case  CHAR :
-    fprintf(stderr, "\"char\"\n"); 
+    fprintf(errfp, "\"char\"\n"); 
     break;
   case EXTERN:
-    fprintf(stderr, "\"extern\"\n"); 
+    fprintf(errfp, "\"extern\"\n"); 
     break;
   case  VOID :
-    fprintf(stderr, "\"void\"\n"); 
+    fprintf(errfp, "\"void\"\n"); 
     break;
   case  INT :
-    fprintf(stderr, "\"int\"\n"); 
+    fprintf(errfp, "\"int\"\n"); 
     break;
   case  IF :
-    fprintf(stderr, "\"if\"\n"); 
+    fprintf(errfp, "\"if\"\n"); 
     break;
   case  ELSE :
-    fprintf(stderr, "\"else\"\n"); 
+    fprintf(errfp, "\"else\"\n"); 
     break;
   case  WHILE :
-    fprintf(stderr, "\"while\"\n"); 
+    fprintf(errfp, "\"while\"\n"); 
     break;
   case  FOR :
-    fprintf(stderr, "\"for\"\n"); 
+    fprintf(errfp, "\"for\"\n"); 
     break;
   case  RETURN :
-    fprintf(stderr, "\"return\""); 
+    fprintf(errfp, "\"return\""); 
     break;
   case  AND :
-    fprintf(stderr, "\"&&\"\n"); 
+    fprintf(errfp, "\"&&\"\n"); 
     break;
   case  OR :
-    fprintf(stderr, "\"||\"\n"); 
+    fprintf(errfp, "\"||\"\n"); 
     break;
   case  EQ :
-    fprintf(stderr, "\"==\"\n"); 
+    fprintf(errfp, "\"==\"\n"); 
     break;
   case  NEQ :
-    fprintf(stderr, "\"!=\"\n"); 
+    fprintf(errfp, "\"!=\"\n"); 
     break;
   case  LE :
-    fprintf(stderr, "\"<=\"\n"); 
+    fprintf(errfp, "\"<=\"\n"); 
     break;
   case  GE :
-    fprintf(stderr, "\">=\"\n"); 
+    fprintf(errfp, "\">=\"\n"); 
     break;
   case  ',' :
   case  '(' :
@@ -105,40 +124,45 @@ void report(int tok_type)
   case  '/' :
   case  '<' :
   case  '>' :
-    fprintf(stderr, "\"%c\"\n", tok_type); 
+    fprintf(errfp, "\"%c\"\n", tok_type); 
     break;
   case '\'' :
-    fprintf(stderr, "\"'\"\n");
+    fprintf(errfp, "\"'\"\n");
     break;
-  default : fprintf(stderr, "UNKNOWN TOKEN VALUE: %d\n", tok_type);
+  default : fprintf(errfp, "UNKNOWN TOKEN VALUE: %d\n", tok_type);
   }
 }
 
-void yyerror(char *s)
+/*
+ * SyntaxError(s, tok) -- report the syntax error s, found with tok as
+ * the lookahead token.  This is the parser's yyerror() (see parser.y).
+ */
+void SyntaxError(char *s, int tok)
 {
+  errcount++;
   switch (errstate) {
   case ORDINARY:
-    fprintf(stderr, "%s: line %d, near ", s, linenum);
-    report(yychar);
+    fprintf(errfp, "%s: line %d, near ", s, linenum);
+    report(tok);
     break;
   case NOCOMMA:
-    fprintf(stderr, "%s, line %d: missing \",\"\n", s, linenum);
+    fprintf(errfp, "%s, line %d: missing \",\"\n", s, linenum);
     errstate = ORDINARY;
     break;
   case NOSEMICOLON:
-	  fprintf(stderr, "%s, line %d: missing \";\"\n", s, linenum);
+	  fprintf(errfp, "%s, line %d: missing \";\"\n", s, linenum);
 	  errstate = ORDINARY;
 	  break;
   case NOLPAREN:
-    fprintf(stderr, "%s, line %d: missing \"(\"\n", s, linenum);
+    fprintf(errfp, "%s, line %d: missing \"(\"\n", s, linenum);
     errstate = ORDINARY;
     break;
   case NORPAREN:
-    fprintf(stderr, "%s, line %d: missing \")\"\n", s, linenum);
+    fprintf(errfp, "%s, line %d: missing \")\"\n", s, linenum);
     errstate = ORDINARY;
     break;
   case NORBRACE:
-    fprintf(stderr, "%s, line %d: missing \"}\"\n", s, linenum);
+    fprintf(errfp, "%s, line %d: missing \"}\"\n", s, linenum);
     errstate = ORDINARY;
     break;
   }
@@ -18,6 +18,10 @@
 
 #define CASSERT(cond, msg)  if (!(cond)) errmsg msg ;
 
+extern THREAD_LOCAL int errcount;   /* no. of errors reported so far */
+
 void errmsg(const char *fmt, ...);
+void warnmsg(const char *fmt, ...);
+void SyntaxError(char *s, int tok);
 
 #endif /* _ERROR_H_ */
@@ -9,13 +9,23 @@
 #define _GLOBAL_H_
 
 #include <assert.h>
+#include <setjmp.h>
 #include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+
+/*
+ * All the state of a compilation is kept in thread-local variables, so
+ * that different threads can compile different files at the same time
+ * (see Compile() in compile.c).
+ */
+#define THREAD_LOCAL __thread
+
 #include "error.h"
 #include "util.h"
+#include "stats.h"
 
 #define t_Char   0
 #define t_Int    1
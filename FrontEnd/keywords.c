@@ -0,0 +1,70 @@
+/*
+ * keywords.c -- the keyword table of C--, shared by both scanners.
+ *
+ * The keywords are found through a perfect hash on the first two
+ * characters and the length of a word, so each identifier is compared
+ * against at most one keyword.  The hash table is built from keywd_table
+ * the first time Keyword() is called; if a new keyword collides with an
+ * existing one, KWHASH() has to be changed.
+ */
+
+#include "global.h"
+#include "syntax-tree.h"
+#include "y.tab.h"
+#include "keywords.h"
+
+static struct {
+     char *name;
+     int val;
+    } keywd_entry,
+      keywd_table[] = {
+       {"char",          CHAR},
+       {"int",           INT},
+       {"void",          VOID},
+       {"extern",	 EXTERN},
+       {"if",            IF},
+       {"else",          ELSE},
+       {"while",         WHILE},
+       {"for",           FOR},
+       {"return",        RETURN},
+      };
+
+#define KWHASHSZ  16   /* a power of 2 */
+#define KWHASH(s, len) \
+  (((unsigned char) (s)[0] + (unsigned char) (s)[1] + (len)) & (KWHASHSZ-1))
+
+static THREAD_LOCAL int keywd_hash[KWHASHSZ];  /* index+1 into keywd_table; 0 if none */
+
+static void init_keywd_hash(void)
+{
+  int i, h, nkeywds;
+
+  nkeywds = sizeof(keywd_table) / sizeof(keywd_entry);
+  for (i = 0; i < nkeywds; i++) {
+    h = KWHASH(keywd_table[i].name, strlen(keywd_table[i].name));
+    assert(keywd_hash[h] == 0);
+    keywd_hash[h] = i+1;
+  }
+}
+
+/*
+ * Keyword(s, len) -- if the word s, of length len, is a keyword, return
+ * its token (see y.tab.h); otherwise return ID.
+ */
+int Keyword(char *s, int len)
+{
+  static THREAD_LOCAL bool initialized = false;
+  int k;
+
+  if (!initialized) {
+    init_keywd_hash();
+    initialized = true;
+  }
+
+  k = keywd_hash[KWHASH(s, len)];
+  if (k != 0 && !strcmp(s, keywd_table[k-1].name)) {
+    return keywd_table[k-1].val;
+  }
+
+  return ID;
+}
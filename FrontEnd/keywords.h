@@ -0,0 +1,11 @@
+/*
+ * keywords.h -- recognizing the keywords of C--, for both scanners
+ * (scanner.l and simdscan.c).
+ */
+
+#ifndef _KEYWORDS_H_
+#define _KEYWORDS_H_
+
+int Keyword(char *s, int len);
+
+#endif  /* _KEYWORDS_H_ */
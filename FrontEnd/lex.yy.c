@@ -487,17 +487,24 @@ char *yytext;
 #include "global.h"
 #include "syntax-tree.h"
 #include "y.tab.h"
+#include "scanner.h"
+#include "keywords.h"
 
 extern void *malloc();
 
 static int id_or_keywd(char *s);
+static char *string_lexeme(void);
 
-char *id_name;
-int ival;
-int linenum = 1;
-#line 498 "lex.yy.c"
+THREAD_LOCAL char *id_name;
+THREAD_LOCAL char *strval;
+THREAD_LOCAL int ival;
+THREAD_LOCAL int linenum = 1;
+THREAD_LOCAL bool scan_in_place = false;
+
+const bool scanner_thread_safe = false;
+#line 505 "lex.yy.c"
 #define YY_NO_INPUT 1
-#line 500 "lex.yy.c"
+#line 507 "lex.yy.c"
 
 #define INITIAL 0
 #define Comment 1
@@ -713,9 +720,9 @@ YY_DECL
 		}
 
 	{
-#line 26 "scanner.l"
+#line 33 "scanner.l"
 
-#line 718 "lex.yy.c"
+#line 725 "lex.yy.c"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -774,200 +781,200 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 27 "scanner.l"
+#line 34 "scanner.l"
 BEGIN(Comment);
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 28 "scanner.l"
+#line 35 "scanner.l"
 ;
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 29 "scanner.l"
+#line 36 "scanner.l"
 ;
 	YY_BREAK
 case 4:
 /* rule 4 can match eol */
 YY_RULE_SETUP
-#line 30 "scanner.l"
+#line 37 "scanner.l"
 linenum++;
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 31 "scanner.l"
+#line 38 "scanner.l"
 BEGIN(INITIAL);
 	YY_BREAK
 case YY_STATE_EOF(Comment):
-#line 32 "scanner.l"
-{fprintf(stderr,
+#line 39 "scanner.l"
+{fprintf(errfp,
 				 "syntax error: EOF inside comment: line %d\n",
 				linenum);
-			 exit(-1);
+			 CompileAbort();
 			}
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 37 "scanner.l"
+#line 44 "scanner.l"
 ;
 	YY_BREAK
 case 7:
 /* rule 7 can match eol */
 YY_RULE_SETUP
-#line 38 "scanner.l"
+#line 45 "scanner.l"
 linenum++;
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 39 "scanner.l"
+#line 46 "scanner.l"
 return(id_or_keywd(yytext));
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 40 "scanner.l"
+#line 47 "scanner.l"
 { ival = atoi(yytext); return(INTCON);}
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 41 "scanner.l"
+#line 48 "scanner.l"
 { ival = yytext[1]; return(CHARCON); }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 42 "scanner.l"
+#line 49 "scanner.l"
 { ival = '\n'; return(CHARCON); }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 43 "scanner.l"
+#line 50 "scanner.l"
 { ival = '\0'; return(CHARCON); }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 44 "scanner.l"
-return(STRINGCON);
+#line 51 "scanner.l"
+{ strval = string_lexeme(); return(STRINGCON); }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 45 "scanner.l"
+#line 52 "scanner.l"
 return(',');
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 46 "scanner.l"
+#line 53 "scanner.l"
 return('(');
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 47 "scanner.l"
+#line 54 "scanner.l"
 return(')');
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 48 "scanner.l"
+#line 55 "scanner.l"
 return(';');
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 49 "scanner.l"
+#line 56 "scanner.l"
 return('{');
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 50 "scanner.l"
+#line 57 "scanner.l"
 return('}');
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 51 "scanner.l"
+#line 58 "scanner.l"
 return('[');
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 52 "scanner.l"
+#line 59 "scanner.l"
 return(']');
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 53 "scanner.l"
+#line 60 "scanner.l"
 return('=');
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 54 "scanner.l"
+#line 61 "scanner.l"
 return(AND);
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 55 "scanner.l"
+#line 62 "scanner.l"
 return(OR);
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 56 "scanner.l"
+#line 63 "scanner.l"
 return('!');
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 57 "scanner.l"
+#line 64 "scanner.l"
 return(EQ);
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 58 "scanner.l"
+#line 65 "scanner.l"
 return(NEQ);
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 59 "scanner.l"
+#line 66 "scanner.l"
 return('+');
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 60 "scanner.l"
+#line 67 "scanner.l"
 return('-');
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 61 "scanner.l"
+#line 68 "scanner.l"
 return('*');
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 62 "scanner.l"
+#line 69 "scanner.l"
 return('/');
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 63 "scanner.l"
+#line 70 "scanner.l"
 return(LE);
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 64 "scanner.l"
+#line 71 "scanner.l"
 return('<');
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 65 "scanner.l"
+#line 72 "scanner.l"
 return(GE);
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 66 "scanner.l"
+#line 73 "scanner.l"
 return('>');
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 67 "scanner.l"
+#line 74 "scanner.l"
 return yytext[0];
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
-#line 68 "scanner.l"
+#line 75 "scanner.l"
 ECHO;
 	YY_BREAK
-#line 970 "lex.yy.c"
+#line 977 "lex.yy.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -1935,43 +1942,45 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 68 "scanner.l"
+#line 75 "scanner.l"
 
-/* id_or_keywd(s) checks a table of keywords to see if the string s matches
-   any of them: if it does, it returns a value depending on the keyword
-   (see the file tokdefs.h), otherwise it returns the value corresponding
-   to ID.
+/* id_or_keywd(s) returns the token for the keyword s (see keywords.c),
+   or ID for any other identifier, whose name is then put in id_name.
 */
 
-static struct {
-     char *name;
-     int val;
-    } keywd_entry,
-      keywd_table[] = {
-       {"char",          CHAR},
-       {"int",           INT},
-       {"void",          VOID},
-       {"extern",	 EXTERN},
-       {"if",            IF},
-       {"else",          ELSE},
-       {"while",         WHILE},
-       {"for",           FOR},
-       {"return",        RETURN},
-      };
-
 static int id_or_keywd(char *s)
 {
-  int i, nkeywds;
+  int tok = Keyword(s, yyleng);
 
-  nkeywds = sizeof(keywd_table) / sizeof(keywd_entry);
-  for (i = 0; i < nkeywds; i++) {
-    if (!strcmp(s, keywd_table[i].name)) {
-      return keywd_table[i].val;
-    }
+  if (tok == ID) {
+    id_name = Intern(yytext, yyleng);
   }
 
-  id_name = strdup(yytext);
+  return tok;
+}
+
+/* string_lexeme() returns the text of the string constant just matched,
+   without the quotes.  When the scanner is working in place on the
+   input (see MapInput() in compile.c), the closing quote is overwritten with
+   a NUL and the string is left where it is in the input buffer, since
+   that is never rescanned; otherwise it is copied.
+*/
 
-  return ID;
+static char *string_lexeme(void)
+{
+  yytext[yyleng-1] = '\0';
+
+  if (scan_in_place) {
+    return yytext+1;
+  }
+
+  return strdup(yytext+1);
+}
+
+/* ScanText() returns the text of the token just scanned. */
+
+char *ScanText(void)
+{
+  return yytext;
 }
 
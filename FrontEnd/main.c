@@ -1,20 +1,296 @@
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
 #include "global.h"
 #include "symbol-table.h"
+#include "syntax-tree.h"
+#include "backend.h"
+#include "cache.h"
+#include "astwrite.h"
+#include "split.h"
+#include "compile.h"
+#include "scanner.h"
+#include "server.h"
 
-extern int yydebug;
-extern int yyparse();
+/*
+ * With several files, or with -j, each file is a job.  A pool of worker
+ * threads takes the jobs in order; the output for file goes to file.out,
+ * and its error messages are collected in memory and written to stderr
+ * by the main thread in the order the files were given, as soon as all
+ * earlier files are done.  So the messages for a file stay together and
+ * come out the same whatever the number of workers.
+ */
+typedef struct {
+  char *path;
+  char *errtext;            /* error messages, from open_memstream() */
+  size_t errlen;
+  int status;
+  long lines;
+  bool done;
+} job;
 
-int status = 0;
+static job *Jobs;
+static int nJobs, nextJob;
+static pthread_mutex_t JobLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t JobDone = PTHREAD_COND_INITIALIZER;
 
-int main(void)
+/*
+ * RunJob(jp) -- compile the file of job jp.
+ */
+static void RunJob(job *jp)
 {
-  SymTabInit(Global);
-  SymTabInit(Local);
+  char *outname;
+  FILE *out, *err;
 
-  if (yyparse() < 0) {
-    printf("main: syntax error\n");
-    status = 1;
+  if ((err = open_memstream(&jp->errtext, &jp->errlen)) == NULL) {
+    fprintf(stderr, "Not enough memory\n");
+    abort();
   }
-  
+
+  outname = zalloc(strlen(jp->path) + 5);
+  sprintf(outname, "%s.out", jp->path);
+  if ((out = fopen(outname, "w")) == NULL) {
+    fprintf(err, "%s: %s\n", outname, strerror(errno));
+    jp->status = 1;
+  }
+  else {
+    jp->status = Compile(jp->path, out, err);
+    jp->lines = StatCounters[CNT_LINES];
+    fclose(out);
+  }
+  free(outname);
+  fclose(err);
+
+  pthread_mutex_lock(&JobLock);
+  jp->done = true;
+  pthread_cond_broadcast(&JobDone);
+  pthread_mutex_unlock(&JobLock);
+}
+
+/*
+ * Worker(arg) -- run jobs until there are none left.
+ */
+static void *Worker(void *arg)
+{
+  int i;
+
+  for (;;) {
+    pthread_mutex_lock(&JobLock);
+    i = nextJob++;
+    pthread_mutex_unlock(&JobLock);
+    if (i >= nJobs) return NULL;
+    RunJob(&Jobs[i]);
+  }
+}
+
+/*
+ * CompileFiles(files, n, nworkers) -- compile the n files with nworkers
+ * threads, and print the files and lines compiled per second.  Returns
+ * the first non-zero status of the files, if any.
+ */
+static int CompileFiles(char **files, int n, int nworkers)
+{
+  pthread_t *tids;
+  struct timespec t0, t1;
+  double secs;
+  long lines = 0;
+  int i, status = 0;
+
+  if (nworkers > 1 && !scanner_thread_safe) {
+    fprintf(stderr, "compile: -j needs the thread-safe scanner "
+	    "(make SCANNER=simdscan); using one thread\n");
+    nworkers = 1;
+  }
+  if (nworkers > n) nworkers = n;
+
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+
+  Jobs = zalloc(n * sizeof(job));
+  for (i = 0; i < n; i++) {
+    Jobs[i].path = files[i];
+  }
+  nJobs = n;
+  nextJob = 0;
+
+  tids = zalloc(nworkers * sizeof(pthread_t));
+  for (i = 0; i < nworkers; i++) {
+    if (pthread_create(&tids[i], NULL, Worker, NULL) != 0) {
+      fprintf(stderr, "compile: can't create worker thread\n");
+      abort();
+    }
+  }
+
+  for (i = 0; i < n; i++) {
+    pthread_mutex_lock(&JobLock);
+    while (!Jobs[i].done) {
+      pthread_cond_wait(&JobDone, &JobLock);
+    }
+    pthread_mutex_unlock(&JobLock);
+
+    fwrite(Jobs[i].errtext, 1, Jobs[i].errlen, stderr);
+    free(Jobs[i].errtext);
+    lines += Jobs[i].lines;
+    if (status == 0) status = Jobs[i].status;
+  }
+
+  for (i = 0; i < nworkers; i++) {
+    pthread_join(tids[i], NULL);
+  }
+  free(tids);
+  free(Jobs);
+
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+  if (secs <= 0) secs = 1e-9;
+  fprintf(stderr, "compile: %d files, %ld lines, %d threads, %.3f s: "
+	  "%.1f files/s, %.0f lines/s\n",
+	  n, lines, nworkers, secs, n / secs, lines / secs);
+
+  return status;
+}
+
+static void Usage(char *prog)
+{
+  fprintf(stderr, "Usage: %s [-j N] [-fbackend-threads=N] [-fparse-threads=N]\n"
+	  "\t[-fcache=DIR] [-fcache-size=MB] [-fdump-ast] [-fpch=PCH]\n"
+	  "\t[-ftime-report[=json]] [-fnode-stats=json] [-fshare-exprs]\n"
+	  "\t[file...]\n"
+	  "       %s --server=SOCKET [--preload=FILE] [-j N] [-f...]\n"
+	  "       %s --client=SOCKET [file]\n"
+	  "       %s --precompile=PCH [-fpch=PCH] file\n", prog, prog, prog, prog);
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  char **files, *arg, *server = NULL, *client = NULL, *preload = NULL;
+  char *pch = NULL, *precompile = NULL;
+  int i, nfiles = 0, nworkers = 0, status;
+  bool plain = true;      /* no options given */
+
+  files = zalloc(argc * sizeof(char *));
+
+  for (i = 1; i < argc; i++) {
+    if (argv[i][0] == '-') {
+      plain = false;
+    }
+    if (strncmp(argv[i], "--server=", 9) == 0) {
+      server = argv[i]+9;
+    }
+    else if (strncmp(argv[i], "--client=", 9) == 0) {
+      client = argv[i]+9;
+    }
+    else if (strncmp(argv[i], "--preload=", 10) == 0) {
+      preload = argv[i]+10;
+    }
+    else if (strncmp(argv[i], "--precompile=", 13) == 0) {
+      precompile = argv[i]+13;
+    }
+    else if (strncmp(argv[i], "-fpch=", 6) == 0) {
+      pch = argv[i]+6;
+    }
+    else if (strcmp(argv[i], "-ftime-report") == 0) {
+      time_report = 1;
+    }
+    else if (strcmp(argv[i], "-ftime-report=json") == 0) {
+      time_report = 2;
+    }
+    else if (strcmp(argv[i], "-fnode-stats=json") == 0) {
+      node_stats_json = true;
+    }
+    else if (strcmp(argv[i], "-fshare-exprs") == 0) {
+      share_exprs = true;
+    }
+    else if (strncmp(argv[i], "-fbackend-threads=", 18) == 0) {
+      if ((backend_threads = atoi(argv[i]+18)) < 0) Usage(argv[0]);
+    }
+    else if (strncmp(argv[i], "-fparse-threads=", 16) == 0) {
+      if ((parse_threads = atoi(argv[i]+16)) < 0) Usage(argv[0]);
+    }
+    else if (strncmp(argv[i], "-fcache=", 8) == 0) {
+      cache_dir = argv[i]+8;
+    }
+    else if (strncmp(argv[i], "-fcache-size=", 13) == 0) {
+      if ((cache_limit = atol(argv[i]+13) * 1024 * 1024) <= 0) Usage(argv[0]);
+    }
+    else if (strcmp(argv[i], "-fdump-ast") == 0) {
+      ast_dump = true;
+    }
+    else if (strncmp(argv[i], "-j", 2) == 0) {
+      arg = (argv[i][2] != '\0' ? argv[i]+2 : argv[++i]);
+      if (arg == NULL || (nworkers = atoi(arg)) <= 0) Usage(argv[0]);
+    }
+    else if (argv[i][0] != '-') {
+      files[nfiles++] = argv[i];
+    }
+    else {
+      Usage(argv[0]);
+    }
+  }
+
+  if (parse_threads > 0 && !scanner_thread_safe) {
+    fprintf(stderr, "compile: -fparse-threads needs the thread-safe scanner "
+	    "(make SCANNER=simdscan); ignored\n");
+    parse_threads = 0;
+  }
+  if (cache_dir != NULL && !scanner_thread_safe) {
+    fprintf(stderr, "compile: -fcache needs the thread-safe scanner "
+	    "(make SCANNER=simdscan); ignored\n");
+    cache_dir = NULL;
+  }
+  if (cache_dir != NULL && ast_dump) {
+    fprintf(stderr, "compile: -fcache can't be used with -fdump-ast; ignored\n");
+    cache_dir = NULL;
+  }
+  if (cache_dir != NULL && !CacheOpen()) {
+    cache_dir = NULL;
+  }
+
+  if ((server != NULL && (client != NULL || nfiles > 0))
+      || (client != NULL && (nfiles > 1 || nworkers > 0))
+      || (preload != NULL && server == NULL)
+      || ((ast_dump || pch != NULL) && client != NULL)
+      || (ast_dump && server != NULL)
+      || (precompile != NULL && (server != NULL || client != NULL || nfiles != 1))) {
+    Usage(argv[0]);
+  }
+
+  /*
+   * With COMPILE_SERVER set in the environment, a plain compilation of
+   * one file goes to the server there, if it is running.
+   */
+  if (plain && nfiles <= 1 && client == NULL) {
+    arg = getenv("COMPILE_SERVER");
+    if (arg != NULL && *arg != '\0'
+	&& ClientCompile(arg, (nfiles == 1 ? files[0] : NULL), true, &status)) {
+      free(files);
+      return status;
+    }
+  }
+
+  if (pch != NULL && !UsePrecompiled(pch)) {
+    free(files);
+    return 1;
+  }
+
+  if (precompile != NULL) {
+    status = Precompile(files[0], precompile, stderr);
+  }
+  else if (server != NULL) {
+    status = ServerMain(server, preload, nworkers > 0 ? nworkers : 1);
+  }
+  else if (client != NULL) {
+    if (!ClientCompile(client, (nfiles == 1 ? files[0] : NULL), false, &status)) {
+      status = 1;
+    }
+  }
+  else if (nfiles > 1 || (nfiles == 1 && nworkers > 0)) {
+    status = CompileFiles(files, nfiles, nworkers > 0 ? nworkers : 1);
+  }
+  else {
+    status = Compile(nfiles == 1 ? files[0] : NULL, stdout, stderr);
+  }
+  free(files);
+
   return status;
 }
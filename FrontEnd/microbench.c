@@ -0,0 +1,697 @@
+/*
+ * microbench.c -- measure the hot paths of the front end one at a time.
+ *
+ * Usage: microbench [-n ops] [-w warmup] [-r reps] [-f file] [-e] [name...]
+ *
+ * Each benchmark does ops operations (default 100000) per repetition,
+ * and is run warmup times (default 3) before reps timed repetitions
+ * (default 100); the time per operation is reported as the minimum,
+ * median, 90th and 99th percentiles and maximum over the repetitions.
+ * With fewer than 100 repetitions the 99th percentile is the maximum.
+ * The lex benchmark scans file, or a built-in sample if none is given,
+ * and counts tokens as operations.  With -e, the cycles, instructions
+ * and cache misses per operation (medians) are counted too, with
+ * perf_event_open(2) on Linux.  Given names, only the benchmarks whose
+ * names start with one of them are run.
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include "global.h"
+#include "scanner.h"
+#include "symbol-table.h"
+#include "syntax-tree.h"
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+static int nOps = 100000;
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                        HARDWARE COUNTERS                          *
+ *                                                                   *
+ *********************************************************************/
+
+#define NPERF 3
+static char *PerfName[NPERF] = {"cycles", "insns", "cache-miss"};
+static int PerfFd[NPERF] = {-1, -1, -1};
+static bool perf = false;
+
+/*
+ * PerfOpen() -- open a group of counters for cycles, instructions and
+ * cache misses of this thread in user mode.  Returns false if they
+ * can't be had.
+ */
+static bool PerfOpen(void)
+{
+#ifdef __linux__
+  static unsigned long long config[NPERF] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES
+  };
+  struct perf_event_attr pe;
+  int i;
+
+  for (i = 0; i < NPERF; i++) {
+    memset(&pe, 0, sizeof(pe));
+    pe.type = PERF_TYPE_HARDWARE;
+    pe.size = sizeof(pe);
+    pe.config = config[i];
+    pe.disabled = (i == 0);
+    pe.exclude_kernel = 1;
+    pe.exclude_hv = 1;
+    pe.read_format = PERF_FORMAT_GROUP;
+    PerfFd[i] = syscall(__NR_perf_event_open, &pe, 0, -1, PerfFd[0], 0);
+    if (PerfFd[i] < 0) {
+      fprintf(stderr, "microbench: no hardware counters: %s\n", strerror(errno));
+      while (--i >= 0) close(PerfFd[i]);
+      return false;
+    }
+  }
+  return true;
+#else
+  fprintf(stderr, "microbench: no hardware counters on this system\n");
+  return false;
+#endif
+}
+
+static void PerfStart(void)
+{
+#ifdef __linux__
+  ioctl(PerfFd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(PerfFd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+/*
+ * PerfStop(counts) -- stop the counters and put their values in counts.
+ */
+static void PerfStop(double *counts)
+{
+#ifdef __linux__
+  unsigned long long buf[1 + NPERF];
+  int i;
+
+  ioctl(PerfFd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  if (read(PerfFd[0], buf, sizeof(buf)) != sizeof(buf)) {
+    memset(buf, 0, sizeof(buf));
+  }
+  for (i = 0; i < NPERF; i++) {
+    counts[i] = buf[1 + i];
+  }
+#endif
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                              SCANNER                              *
+ *                                                                   *
+ *********************************************************************/
+
+static char *Sample =
+  "/* sum of the elements of an array */\n"
+  "int sum(int a[], int n)\n"
+  "{\n"
+  "  int i, s;\n"
+  "  s = 0;\n"
+  "  for (i = 0; i < n; i = i + 1) {\n"
+  "    s = s + a[i] * 2 - (i / 3);\n"
+  "  }\n"
+  "  if (s >= 1000 && !(n == 0) || s != -1) print(\"big\\n\", '\\n');\n"
+  "  return s;\n"
+  "}\n";
+
+static char *Text, *ScanBuf;    /* the text, and a copy to scan in place */
+static size_t TextLen;
+
+/*
+ * LoadText(path) -- read the file path, or repeat the sample text to
+ * about 64K bytes if path is NULL.
+ */
+static void LoadText(char *path)
+{
+  FILE *fp;
+  long len;
+  size_t n;
+
+  if (path == NULL) {
+    n = strlen(Sample);
+    Text = zalloc(65536 + n + 1);
+    for (TextLen = 0; TextLen < 65536; TextLen += n) {
+      memcpy(Text + TextLen, Sample, n);
+    }
+  }
+  else {
+    if ((fp = fopen(path, "r")) == NULL) {
+      perror(path);
+      exit(1);
+    }
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    rewind(fp);
+    Text = zalloc(len + 1);
+    if (fread(Text, 1, len, fp) != (size_t) len) {
+      perror(path);
+      exit(1);
+    }
+    fclose(fp);
+    TextLen = len;
+  }
+  ScanBuf = zalloc(TextLen + 2);
+}
+
+/*
+ * The scanner writes into the text it scans in place (see
+ * DoCompile()), so each repetition gets a fresh copy.
+ */
+static void PrepLex(void)
+{
+  memcpy(ScanBuf, Text, TextLen);
+  ScanBuf[TextLen] = ScanBuf[TextLen+1] = '\0';
+  linenum = 1;
+  yy_scan_buffer(ScanBuf, TextLen + 2);
+  scan_in_place = true;
+}
+
+static long RunLex(void)
+{
+  long ntoks = 0;
+
+  while (yylex() != 0) {
+    ntoks++;
+  }
+  yylex_destroy();
+  return ntoks;
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                           SYMBOL TABLE                            *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * Names for the symbol table benchmarks, as atoms: SeqNames are v0, v1,
+ * ..., PrefixNames share a long prefix, ShortNames have one or two
+ * letters (and repeat every 702), MissNames are never inserted.  Zipf
+ * is a sequence of indexes into SeqNames in which index i comes up with
+ * a probability proportional to 1/(i+1).
+ */
+static char **SeqNames, **PrefixNames, **ShortNames, **MissNames;
+static int *Zipf;
+
+static char **MakeNames(char *fmt)
+{
+  char **names = zalloc(nOps * sizeof(char *));
+  char buf[64];
+  int i;
+
+  for (i = 0; i < nOps; i++) {
+    sprintf(buf, fmt, i);
+    names[i] = Intern(buf, strlen(buf));
+  }
+  return names;
+}
+
+static void MakeZipf(void)
+{
+  double *cum = zalloc(nOps * sizeof(double)), sum = 0, u;
+  unsigned long long r = 88172645463325252ULL;
+  int i, lo, hi, mid;
+
+  for (i = 0; i < nOps; i++) {
+    sum += 1.0 / (i + 1);
+    cum[i] = sum;
+  }
+  Zipf = zalloc(nOps * sizeof(int));
+  for (i = 0; i < nOps; i++) {
+    r ^= r << 13;
+    r ^= r >> 7;
+    r ^= r << 17;
+    u = (r >> 11) * (1.0 / 9007199254740992.0) * sum;
+    for (lo = 0, hi = nOps - 1; lo < hi; ) {
+      mid = (lo + hi) / 2;
+      if (cum[mid] < u) lo = mid + 1; else hi = mid;
+    }
+    Zipf[i] = lo;
+  }
+  free(cum);
+}
+
+static void MakeSymNames(void)
+{
+  char **names;
+  char buf[3] = {0, 0, 0};
+  int i;
+
+  SeqNames = MakeNames("v%d");
+  PrefixNames = MakeNames("a_rather_long_common_prefix_for_names_%d");
+  MissNames = MakeNames("missing%d");
+  names = zalloc(nOps * sizeof(char *));
+  for (i = 0; i < nOps; i++) {
+    if (i % 702 < 26) {
+      buf[0] = 'a' + i % 702;
+      buf[1] = '\0';
+    }
+    else {
+      buf[0] = 'a' + (i % 702 - 26) / 26;
+      buf[1] = 'a' + (i % 702 - 26) % 26;
+    }
+    names[i] = Intern(buf, strlen(buf));
+  }
+  ShortNames = names;
+  MakeZipf();
+}
+
+/*
+ * The Local table is emptied before each repetition of an insertion
+ * benchmark.  Short names repeat, so they are inserted in block scopes
+ * of 702 names each, the way a deeply nested function would have them.
+ */
+static void PrepInsert(void)
+{
+  SymTabInit(Local);
+  RegionReset(RGN_FUNCTION);
+}
+
+static long InsertNames(char **names)
+{
+  int i;
+
+  for (i = 0; i < nOps; i++) {
+    SymTabInsert(names[i], Local);
+  }
+  return nOps;
+}
+
+static long RunInsertSeq(void)    { return InsertNames(SeqNames); }
+static long RunInsertPrefix(void) { return InsertNames(PrefixNames); }
+
+static long RunInsertShort(void)
+{
+  int i;
+
+  for (i = 0; i < nOps; i++) {
+    if (i % 702 == 0 && i > 0) {
+      SymTabEnterScope();
+    }
+    SymTabInsert(ShortNames[i], Local);
+  }
+  return nOps;
+}
+
+/*
+ * For the lookups, v0 ... are in the Local table and prefixed names in
+ * the Global table, so that finding one of those looks in both.
+ */
+static void PrepLookup(void)
+{
+  static bool done = false;
+  int i;
+
+  if (done) return;
+  SymTabInit(Local);
+  SymTabInit(Global);
+  RegionReset(RGN_FUNCTION);
+  for (i = 0; i < nOps; i++) {
+    SymTabInsert(SeqNames[i], Local);
+    SymTabInsert(PrefixNames[i], Global);
+  }
+  done = true;
+}
+
+static long LookupNames(char **names, int *order)
+{
+  int i;
+
+  for (i = 0; i < nOps; i++) {
+    if (SymTabLookupAll(names[order != NULL ? order[i] : i]) == (void *) names) {
+      abort();        /* never: keeps the lookups from being optimized away */
+    }
+  }
+  return nOps;
+}
+
+static long RunLookupSeq(void)    { return LookupNames(SeqNames, NULL); }
+static long RunLookupZipf(void)   { return LookupNames(SeqNames, Zipf); }
+static long RunLookupGlobal(void) { return LookupNames(PrefixNames, NULL); }
+static long RunLookupMiss(void)   { return LookupNames(MissNames, NULL); }
+
+/*********************************************************************
+ *                                                                   *
+ *                            ALLOCATION                             *
+ *                                                                   *
+ *********************************************************************/
+
+static void *Blocks[256];
+
+/*
+ * RunZalloc() -- zalloc() blocks of 16 to 128 bytes, freeing them 256
+ * at a time.
+ */
+static long RunZalloc(void)
+{
+  int i, j;
+
+  for (i = 0; i < nOps; i += 256) {
+    for (j = 0; j < 256; j++) {
+      Blocks[j] = zalloc(16 + (j & 7) * 16);
+    }
+    for (j = 0; j < 256; j++) {
+      free(Blocks[j]);
+    }
+  }
+  return (nOps + 255) / 256 * 256;
+}
+
+static void PrepRalloc(void)
+{
+  RegionReset(RGN_FUNCTION);
+}
+
+static long RunRalloc(void)
+{
+  int i;
+
+  for (i = 0; i < nOps; i++) {
+    Blocks[i & 255] = ralloc(RGN_FUNCTION, 16 + (i & 7) * 16);
+  }
+  return nOps;
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                        NODE CONSTRUCTORS                          *
+ *                                                                   *
+ *********************************************************************/
+
+static symtabnode *VarSym;
+
+static void PrepNodes(void)
+{
+  SynTreeReset();
+  if (VarSym == NULL) {
+    VarSym = zalloc(sizeof(symtabnode));
+    VarSym->name = Intern("x", 1);
+    VarSym->type = t_Int;
+  }
+}
+
+static long RunMkConst(void)
+{
+  int i;
+
+  for (i = 0; i < nOps; i++) {
+    mkConstNode(Intcon, t_Int, i);
+  }
+  return nOps;
+}
+
+static long RunMkSymTabRef(void)
+{
+  int i;
+
+  for (i = 0; i < nOps; i++) {
+    mkSymTabRefNode(Var, t_Int, VarSym, NULL);
+  }
+  return nOps;
+}
+
+static long RunMkExpr(void)
+{
+  tnode *t = mkConstNode(Intcon, t_Int, 1);
+  int i;
+
+  for (i = 1; i < nOps; i++) {
+    t = mkExprNode(Plus, t_Int, t, t);
+  }
+  return nOps;
+}
+
+static long RunMkST(void)
+{
+  tnode *t = mkConstNode(Intcon, t_Int, 1);
+  int i;
+
+  for (i = 1; i < nOps; i++) {
+    t = mkSTNode(While, t_None, t, t, NULL, NULL);
+  }
+  return nOps;
+}
+
+static long RunMkList(void)
+{
+  tnseq s = {NULL, NULL};
+  tnode *t = mkConstNode(Intcon, t_Int, 1);
+  int i;
+
+  for (i = 1; i < nOps; i++) {
+    s = SeqAppend(s, t);
+  }
+  return nOps;
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                        ARGUMENT CHECKING                          *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * A function with Arity formals, int, char and int[] in turn, and a list
+ * of actuals that matches them.
+ */
+static int Arity;
+static symtabnode *Callee;
+static tnode *Actuals;
+
+static void PrepActuals(void)
+{
+  symtabnode *formal, *arr;
+  tnseq s = {NULL, NULL};
+  int i;
+
+  SynTreeReset();
+  RegionReset(RGN_FUNCTION);
+  Callee = ralloc(RGN_FUNCTION, sizeof(symtabnode));
+  Callee->name = Intern("callee", 6);
+  Callee->type = t_Func;
+  Callee->ret_type = t_Int;
+  arr = ralloc(RGN_FUNCTION, sizeof(symtabnode));
+  arr->name = Intern("arr", 3);
+  arr->type = t_Array;
+  arr->elt_type = t_Int;
+  for (i = Arity - 1; i >= 0; i--) {
+    formal = ralloc(RGN_FUNCTION, sizeof(symtabnode));
+    formal->type = (i % 3 == 0 ? t_Int : i % 3 == 1 ? t_Char : t_Array);
+    formal->elt_type = (i % 3 == 2 ? t_Int : t_None);
+    formal->formal = true;
+    formal->next = Callee->formals;
+    Callee->formals = formal;
+  }
+  for (i = 0; i < Arity; i++) {
+    s = SeqAppend(s, (i % 3 == 2 ? mkSymTabRefNode(Var, t_Array, arr, NULL)
+		      : mkConstNode(Intcon, t_Int, i)));
+  }
+  Actuals = s.head;
+}
+
+static long RunActuals(void)
+{
+  int i, n = nOps / Arity + 1;
+
+  for (i = 0; i < n; i++) {
+    if (!ActualsMatchFormals(Callee, Actuals)) {
+      abort();
+    }
+  }
+  return n;
+}
+
+static void PrepActuals8(void)   { Arity = 8;   PrepActuals(); }
+static void PrepActuals64(void)  { Arity = 64;  PrepActuals(); }
+static void PrepActuals512(void) { Arity = 512; PrepActuals(); }
+
+/*********************************************************************
+ *                                                                   *
+ *                              DRIVER                               *
+ *                                                                   *
+ *********************************************************************/
+
+typedef struct {
+  char *name;
+  void (*prep)(void);     /* before each repetition, not timed */
+  long (*run)(void);      /* returns the number of operations done */
+} benchmark;
+
+static benchmark Benchmarks[] = {
+  {"lex",            PrepLex,        RunLex},
+  {"insert-seq",     PrepInsert,     RunInsertSeq},
+  {"insert-prefix",  PrepInsert,     RunInsertPrefix},
+  {"insert-short",   PrepInsert,     RunInsertShort},
+  {"lookup-seq",     PrepLookup,     RunLookupSeq},
+  {"lookup-zipf",    PrepLookup,     RunLookupZipf},
+  {"lookup-global",  PrepLookup,     RunLookupGlobal},
+  {"lookup-miss",    PrepLookup,     RunLookupMiss},
+  {"zalloc",         NULL,           RunZalloc},
+  {"ralloc",         PrepRalloc,     RunRalloc},
+  {"mkConstNode",    PrepNodes,      RunMkConst},
+  {"mkSymTabRefNode", PrepNodes,     RunMkSymTabRef},
+  {"mkExprNode",     PrepNodes,      RunMkExpr},
+  {"mkSTNode",       PrepNodes,      RunMkST},
+  {"SeqAppend",      PrepNodes,      RunMkList},
+  {"actuals-8",      PrepActuals8,   RunActuals},
+  {"actuals-64",     PrepActuals64,  RunActuals},
+  {"actuals-512",    PrepActuals512, RunActuals},
+};
+#define NBENCH (sizeof(Benchmarks) / sizeof(Benchmarks[0]))
+
+static int CmpDouble(const void *a, const void *b)
+{
+  double x = *(const double *) a, y = *(const double *) b;
+
+  return (x < y ? -1 : x > y);
+}
+
+/*
+ * Pct(v, n, p) -- the p-th percentile of the n sorted values v, by the
+ * nearest rank.
+ */
+static double Pct(double *v, int n, int p)
+{
+  int k = (p * n + 99) / 100;
+
+  return v[k > 0 ? k-1 : 0];
+}
+
+/*
+ * Run(b, warmup, reps) -- run benchmark b and print a line of results.
+ */
+static void Run(benchmark *b, int warmup, int reps)
+{
+  double *ns = zalloc(reps * sizeof(double));
+  double *counts[NPERF], c[NPERF], t0;
+  long ops = 0;
+  int i, j;
+
+  for (j = 0; j < NPERF; j++) {
+    counts[j] = zalloc(reps * sizeof(double));
+  }
+  for (i = -warmup; i < reps; i++) {
+    if (b->prep != NULL) b->prep();
+    if (perf) PerfStart();
+    t0 = now();
+    ops = b->run();
+    t0 = now() - t0;
+    if (perf) PerfStop(c);
+    if (ops <= 0) break;
+    if (i < 0) continue;
+    ns[i] = t0 / ops;
+    for (j = 0; perf && j < NPERF; j++) {
+      counts[j][i] = c[j] / ops;
+    }
+  }
+
+  if (ops <= 0) {
+    printf("%-16s no operations\n", b->name);
+  }
+  else {
+    qsort(ns, reps, sizeof(double), CmpDouble);
+    printf("%-16s %8ld %9.2f %9.2f %9.2f %9.2f %9.2f", b->name, ops,
+	   ns[0], Pct(ns, reps, 50), Pct(ns, reps, 90), Pct(ns, reps, 99),
+	   ns[reps-1]);
+    for (j = 0; perf && j < NPERF; j++) {
+      qsort(counts[j], reps, sizeof(double), CmpDouble);
+      printf(" %10.2f", Pct(counts[j], reps, 50));
+    }
+    putchar('\n');
+  }
+  fflush(stdout);
+
+  free(ns);
+  for (j = 0; j < NPERF; j++) {
+    free(counts[j]);
+  }
+}
+
+static void Usage(char *prog)
+{
+  fprintf(stderr, "Usage: %s [-n ops] [-w warmup] [-r reps] [-f file] [-e] [name...]\n",
+	  prog);
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  char *path = NULL;
+  int i, j, k, warmup = 3, reps = 100;
+  bool any;
+
+  outfp = stdout;
+  errfp = stderr;
+  for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-e") == 0) {
+      perf = true;
+    }
+    else if (i+1 == argc) {
+      Usage(argv[0]);
+    }
+    else if (strcmp(argv[i], "-n") == 0) {
+      nOps = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "-w") == 0) {
+      warmup = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "-r") == 0) {
+      reps = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "-f") == 0) {
+      path = argv[++i];
+    }
+    else {
+      Usage(argv[0]);
+    }
+  }
+  if (nOps < 1 || warmup < 0 || reps < 1) {
+    Usage(argv[0]);
+  }
+  if (perf) {
+    perf = PerfOpen();
+  }
+
+  LoadText(path);
+  SymTabInit(Global);
+  SymTabInit(Local);
+  MakeSymNames();
+
+  printf("%-16s %8s %9s %9s %9s %9s %9s", "ns/op", "ops", "min", "p50", "p90",
+	 "p99", "max");
+  for (j = 0; perf && j < NPERF; j++) {
+    printf(" %10s", PerfName[j]);
+  }
+  putchar('\n');
+  for (j = 0; j < (int) NBENCH; j++) {
+    any = (i == argc);
+    for (k = i; k < argc && !any; k++) {
+      any = (strncmp(Benchmarks[j].name, argv[k], strlen(argv[k])) == 0);
+    }
+    if (any) {
+      Run(&Benchmarks[j], warmup, reps);
+    }
+  }
+
+  return 0;
+}
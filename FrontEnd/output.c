@@ -0,0 +1,330 @@
+/*
+ * output.c -- buffered output, written by a background thread.
+ *
+ * Each thread has a buffer of its own, between OutBase and OutEnd, with
+ * OutPtr the next free byte; the formatting functions only have to copy
+ * bytes into it, and call Flush() when it is full.  What Flush() does
+ * depends on OutMode:
+ *
+ *   OUT_SYNC:     fwrite() the buffer to OutFile and start over.
+ *   OUT_ASYNC:    queue the buffer for the writer thread, which writes it
+ *                 to OutFile and frees it, and take a new one; a thread
+ *                 with OUT_MAXQUEUED buffers in the queue waits for the
+ *                 writer, so memory use stays bounded.
+ *   OUT_CAPTURE:  make the buffer bigger.
+ *
+ * There is one writer thread for the process, started when first needed.
+ * It writes buffers in the order they were queued, so the output for
+ * each FILE comes out in the order it was produced, as with stdio.
+ */
+
+#include <pthread.h>
+#include <stdarg.h>
+#include "global.h"
+#include "output.h"
+
+#define OUTBUFSZ        (256 * 1024)
+#define OUTCAPSZ        4096    /* initial size of a buffer for OutCapture() */
+#define OUT_MAXQUEUED   4
+
+enum { OUT_CLOSED, OUT_SYNC, OUT_ASYNC, OUT_CAPTURE };
+
+THREAD_LOCAL char *OutPtr, *OutEnd;
+static THREAD_LOCAL char *OutBase;
+static THREAD_LOCAL FILE *OutFile;
+static THREAD_LOCAL int OutMode = OUT_CLOSED;
+static THREAD_LOCAL int OutQueued;       /* buffers of this thread not yet written */
+
+/*
+ * A buffer queued for the writer thread.
+ */
+typedef struct outchunk {
+  char *buf;
+  size_t len;
+  FILE *fp;
+  int *queued;             /* the OutQueued of the thread it came from */
+  struct outchunk *next;
+} outchunk;
+
+static pthread_mutex_t WriterLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t WriterWork = PTHREAD_COND_INITIALIZER;  /* a buffer was queued */
+static pthread_cond_t WriterDone = PTHREAD_COND_INITIALIZER;  /* a buffer was written */
+static pthread_once_t WriterOnce = PTHREAD_ONCE_INIT;
+static outchunk *QueueHead, *QueueTail;
+
+static char *NewBuffer(size_t n)
+{
+  char *buf = malloc(n);
+
+  if (buf == NULL) {
+    fprintf(stderr, "Not enough memory\n");
+    abort();
+  }
+  return buf;
+}
+
+/*
+ * Writer(arg) -- write out the queued buffers, forever.
+ */
+static void *Writer(void *arg)
+{
+  outchunk *cp;
+
+  pthread_mutex_lock(&WriterLock);
+  for (;;) {
+    while (QueueHead == NULL) {
+      pthread_cond_wait(&WriterWork, &WriterLock);
+    }
+    cp = QueueHead;
+    if ((QueueHead = cp->next) == NULL) {
+      QueueTail = NULL;
+    }
+    pthread_mutex_unlock(&WriterLock);
+
+    fwrite(cp->buf, 1, cp->len, cp->fp);
+    free(cp->buf);
+
+    pthread_mutex_lock(&WriterLock);
+    (*cp->queued)--;
+    pthread_cond_broadcast(&WriterDone);
+    free(cp);
+  }
+  return NULL;
+}
+
+static void StartWriter(void)
+{
+  pthread_t tid;
+
+  if (pthread_create(&tid, NULL, Writer, NULL) != 0) {
+    fprintf(stderr, "compile: can't create output thread\n");
+    abort();
+  }
+  pthread_detach(tid);
+}
+
+/*
+ * Flush() -- make room in the buffer of the calling thread, as described
+ * at the top of the file.
+ */
+static void Flush(void)
+{
+  size_t len = OutPtr - OutBase, size = OutEnd - OutBase;
+  outchunk *cp;
+
+  assert(OutMode != OUT_CLOSED);
+
+  switch (OutMode) {
+  case OUT_SYNC:
+    if (len > 0 && OutFile != NULL) {
+      fwrite(OutBase, 1, len, OutFile);
+    }
+    OutPtr = OutBase;
+    break;
+
+  case OUT_ASYNC:
+    if (len == 0) {
+      break;
+    }
+    cp = zalloc(sizeof(outchunk));
+    cp->buf = OutBase;
+    cp->len = len;
+    cp->fp = OutFile;
+    cp->queued = &OutQueued;
+
+    pthread_mutex_lock(&WriterLock);
+    while (OutQueued >= OUT_MAXQUEUED) {
+      pthread_cond_wait(&WriterDone, &WriterLock);
+    }
+    if (QueueTail != NULL) {
+      QueueTail->next = cp;
+    }
+    else {
+      QueueHead = cp;
+    }
+    QueueTail = cp;
+    OutQueued++;
+    pthread_cond_signal(&WriterWork);
+    pthread_mutex_unlock(&WriterLock);
+
+    OutBase = OutPtr = NewBuffer(OUTBUFSZ);
+    OutEnd = OutBase + OUTBUFSZ;
+    break;
+
+  case OUT_CAPTURE:
+    if ((OutBase = realloc(OutBase, 2 * size)) == NULL) {
+      fprintf(stderr, "Not enough memory\n");
+      abort();
+    }
+    OutPtr = OutBase + len;
+    OutEnd = OutBase + 2 * size;
+    break;
+  }
+}
+
+/*
+ * OutOpen(fp, async) -- send the output of the calling thread to fp
+ * (nowhere if fp is NULL), and make it outfp; if async is set, through
+ * the writer thread.
+ */
+void OutOpen(FILE *fp, bool async)
+{
+  assert(OutMode == OUT_CLOSED);
+
+  if (async && fp != NULL) {
+    pthread_once(&WriterOnce, StartWriter);
+  }
+  OutMode = (async && fp != NULL ? OUT_ASYNC : OUT_SYNC);
+  OutFile = outfp = fp;
+  OutBase = OutPtr = NewBuffer(OUTBUFSZ);
+  OutEnd = OutBase + OUTBUFSZ;
+}
+
+/*
+ * OutClose() -- write out the output of the calling thread, and wait
+ * until the writer thread has written all of it.
+ */
+void OutClose(void)
+{
+  Flush();
+  if (OutMode == OUT_ASYNC) {
+    pthread_mutex_lock(&WriterLock);
+    while (OutQueued > 0) {
+      pthread_cond_wait(&WriterDone, &WriterLock);
+    }
+    pthread_mutex_unlock(&WriterLock);
+  }
+
+  free(OutBase);
+  OutBase = OutPtr = OutEnd = NULL;
+  OutFile = outfp = NULL;
+  OutMode = OUT_CLOSED;
+}
+
+/*
+ * OutCapture() -- keep the output of the calling thread in memory, until
+ * OutCaptured().
+ */
+void OutCapture(void)
+{
+  assert(OutMode == OUT_CLOSED);
+
+  OutMode = OUT_CAPTURE;
+  OutBase = OutPtr = NewBuffer(OUTCAPSZ);
+  OutEnd = OutBase + OUTCAPSZ;
+}
+
+/*
+ * OutCaptured(len) -- stop keeping the output in memory, and return it,
+ * in a buffer from malloc(), with its length in *len.
+ */
+char *OutCaptured(size_t *len)
+{
+  char *text = OutBase;
+
+  assert(OutMode == OUT_CAPTURE);
+
+  *len = OutPtr - OutBase;
+  OutBase = OutPtr = OutEnd = NULL;
+  OutMode = OUT_CLOSED;
+  return text;
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                           FORMATTING                              *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * OutFull(c) -- OutChar(c) for a full buffer.
+ */
+void OutFull(int c)
+{
+  Flush();
+  *OutPtr++ = c;
+}
+
+void OutText(char *s, size_t n)
+{
+  size_t k;
+
+  while (n > (size_t) (OutEnd - OutPtr)) {
+    k = OutEnd - OutPtr;
+    memcpy(OutPtr, s, k);
+    OutPtr += k;
+    s += k;
+    n -= k;
+    Flush();
+  }
+  memcpy(OutPtr, s, n);
+  OutPtr += n;
+}
+
+void OutStr(char *s)
+{
+  OutText(s, strlen(s));
+}
+
+/*
+ * OutInt(n) -- write n in decimal, as printf("%ld") does.
+ */
+void OutInt(long n)
+{
+  char buf[24], *p = buf + sizeof(buf);
+  unsigned long u = (n < 0 ? -(unsigned long) n : (unsigned long) n);
+
+  do {
+    *--p = '0' + u % 10;
+    u /= 10;
+  } while (u != 0);
+  if (n < 0) {
+    *--p = '-';
+  }
+  OutText(p, buf + sizeof(buf) - p);
+}
+
+/*
+ * OutSpaces(n) -- write n spaces, none if n < 0.
+ */
+void OutSpaces(int n)
+{
+  int k;
+
+  while (n > 0) {
+    if (OutPtr == OutEnd) {
+      Flush();
+    }
+    k = (n < OutEnd - OutPtr ? n : OutEnd - OutPtr);
+    memset(OutPtr, ' ', k);
+    OutPtr += k;
+    n -= k;
+  }
+}
+
+/*
+ * OutPrintf(fmt, ...) -- printf() to the output, for what the functions
+ * above can't format.
+ */
+void OutPrintf(char *fmt, ...)
+{
+  va_list ap;
+  char buf[256], *p = buf;
+  int n;
+
+  va_start(ap, fmt);
+  n = vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  if (n >= (int) sizeof(buf)) {
+    p = NewBuffer(n + 1);
+    va_start(ap, fmt);
+    vsnprintf(p, n + 1, fmt, ap);
+    va_end(ap);
+  }
+  if (n > 0) {
+    OutText(p, n);
+  }
+  if (p != buf) {
+    free(p);
+  }
+}
@@ -0,0 +1,33 @@
+/*
+ * output.h -- buffered output for the syntax tree dumps and node counts.
+ *
+ * The output of a compilation is formatted with the functions below into
+ * a large buffer of the calling thread, instead of with a stdio call per
+ * item.  After OutOpen(fp, async), a full buffer is written to fp with
+ * one fwrite(); with async set, it is handed instead to a writer thread
+ * shared by all threads, which writes it while the caller goes on
+ * parsing.  OutClose() writes out the rest and waits until all of it is
+ * in fp.  Between OutCapture() and OutCaptured(), the output is kept in
+ * memory instead, e.g. that of a function processed on another thread.
+ */
+
+#ifndef _OUTPUT_H_
+#define _OUTPUT_H_
+
+extern THREAD_LOCAL char *OutPtr, *OutEnd;   /* free part of the buffer */
+
+#define OutChar(c)  (OutPtr < OutEnd ? (void) (*OutPtr++ = (c)) : OutFull(c))
+
+void OutOpen(FILE *fp, bool async);
+void OutClose(void);
+void OutCapture(void);
+char *OutCaptured(size_t *len);
+
+void OutFull(int c);
+void OutText(char *s, size_t n);
+void OutStr(char *s);
+void OutInt(long n);
+void OutSpaces(int n);
+void OutPrintf(char *fmt, ...);
+
+#endif  /* _OUTPUT_H_ */
@@ -15,9 +15,33 @@
 #include "error.h"
 #include "syntax-tree.h"
 #include "symbol-table.h"
+#include "scanner.h"
+#include "backend.h"
 
-extern int yylex();
-extern void yyerror();
+/*
+ * The parser is pure (it keeps its stacks and lookahead in local
+ * variables) so that it can run on several threads at once.  The scanner
+ * returns token values in globals rather than through yylval, so the
+ * arguments that a pure parser passes to yylex() are dropped.  Syntax
+ * errors are reported with the lookahead token, which is local to
+ * yyparse().
+ *
+ * For the statistics in stats.c: tokens are counted (and the scanner
+ * timed) by TimedLex(), which stands in for yylex(), and reductions are
+ * counted by a CountEvent() that the Makefile puts at the start of the
+ * reduction code in y.tab.c, since yacc offers no hook there.
+ */
+extern int TimedLex(void);
+#define yylex(lvalp)  TimedLex()
+#define yyerror(s)    SyntaxError(s, yychar)
+
+/*
+ * A fatal error in the scanner leaves yyparse() by CompileAbort()'s
+ * longjmp(), so the stacks must never be moved to the heap, where they
+ * would then leak; they start out at their maximum size instead.
+ */
+#define YYMAXDEPTH   10000
+#define YYINITDEPTH  YYMAXDEPTH
 
 /*
  * The function process_syntax_tree() is defined in the file 
@@ -29,37 +53,38 @@ extern void yyerror();
  * body.
  *
  * Syntax tree processing can be customized by replacing the code for
- * this function.
+ * this function.  It is called through BackendSubmit() (backend.c),
+ * which may run it on another thread while parsing goes on.
  */
-extern void process_syntax_tree(symtabnode *fn_name, struct treenode *fn_body);
 
   /*
    * struct treenode *currfnbodyTree is set to point to
    * the syntax tree for the body of the current function
    * at the end of each function.  
-   * NOTE: the syntax tree MUST be used before CleanupFnInfo()
-   * is called at the end of the function.  After that the
-   * symbol table entries for the local variables of the
-   * function will go away, leaving dangling pointers from
-   * the syntax tree.
+   * NOTE: the syntax tree MUST be used, or handed to
+   * BackendSubmit(), before CleanupFnInfo() is called at the
+   * end of the function.  After that the symbol table entries
+   * for the local variables of the function will go away,
+   * leaving dangling pointers from the syntax tree.
    */
-struct treenode *currfnbodyTree = NULL;
-
-extern char *id_name, *yytext;
-extern int ival;
-extern int linenum;
-char *fnName;
-symtabnode *stptr, *currFun;
-int CurrType, EltType, fnRetType;
-int CurrScope = Global;
-llistptr lptr;
-bool is_extern;
-int errstate = 0;
+THREAD_LOCAL struct treenode *currfnbodyTree = NULL;
+
+THREAD_LOCAL char *fnName;
+THREAD_LOCAL symtabnode *stptr, *currFun;
+THREAD_LOCAL int CurrType, EltType, fnRetType;
+THREAD_LOCAL int CurrScope = Global;
+THREAD_LOCAL llistptr lptr;
+THREAD_LOCAL bool is_extern;
+THREAD_LOCAL int errstate = 0;
 %}
 
+%define api.pure
+
 %union {
   tnptr tptr;
   llistptr idlistptr;
+  llseq idseq;
+  tnseq tseq;
   char *chptr;
   int nval;
 }
@@ -74,12 +99,16 @@ int errstate = 0;
 %token '[' ']'
 
 %type <chptr> Ident;
-%type <nval> type ArraySize;
-%type <idlistptr> parm_types nonempty_parm_type_list parm_type_decl;
-%type <tptr> stmt_list stmt compound_stmt optional_else
+%type <nval> type ArraySize block_start;
+%type <idlistptr> parm_types parm_type_decl;
+%type <idseq> nonempty_parm_type_list;
+%type <tseq> stmt_list stmts expr_list;
+%type <tptr> stmt compound_stmt optional_else
    optional_assgt optional_expr optional_boolexp
    assignment boolexp expr fun_call proc_call
-   variable expr_list;
+   variable;
+
+%destructor { SymTabExitScope($$); } block_start
 
 %nonassoc dangling_else
 %left  AND OR
@@ -107,7 +136,10 @@ prog
        * for the body of the current function.  This can then
        * be traversed for code generation etc.
        */
-      process_syntax_tree(currFun, currfnbodyTree);
+      CountEvent(CNT_FUNCS, 1);
+      PhaseBegin(PH_PROCESS);
+      BackendSubmit(currFun, currfnbodyTree);
+      PhaseEnd();
 
       CleanupFnInfo(); 
     }
@@ -143,12 +175,16 @@ fprototype
   
 parm_types
   : VOID { $$ = NULL; }
-  | nonempty_parm_type_list { $$ = $1; }
+  | nonempty_parm_type_list { lptr = $1.head; $$ = lptr; }
   ;
 
+/*
+ * Lists are built left-recursively, appending at the tail, so that
+ * the parser stack stays shallow and building a list takes linear time.
+ */
 nonempty_parm_type_list
-: nonempty_parm_type_list comma parm_type_decl { lptr = Attach($1, $3); $$ = lptr; }
-  | parm_type_decl { $$ = $1; }
+: nonempty_parm_type_list comma parm_type_decl { $$ = LSeqAppend($1, $3); }
+  | parm_type_decl { $$ = LSeqAppend((llseq){NULL, NULL}, $1); }
   ;
 
 parm_type_decl
@@ -204,12 +240,24 @@ id_decl
   }
   ;
 
-ArraySize : INTCON { $$ = atoi(yytext); }
+ArraySize : INTCON { $$ = ival; }
 ;
 
+/*
+ * The statements are a separate nonterminal from the empty list so that
+ * a syntax error right after the declarations is still recovered from
+ * by "stmt : error", as with a right-recursive list: otherwise the only
+ * item in that state is the empty list, and recovery would throw away
+ * the enclosing block or function.
+ */
 stmt_list
-  : stmt stmt_list { $$ = mkListNode($1, $2); }
-  | { $$ = NULL; }   /* epsilon */ 
+  : stmts { $$ = $1; }
+  | { $$ = (tnseq){NULL, NULL}; }   /* epsilon */ 
+  ;
+
+stmts
+  : stmts stmt { $$ = SeqAppend($1, $2); }
+  | stmt { $$ = SeqAppend((tnseq){NULL, NULL}, $1); }
   ;
 
 stmt
@@ -225,11 +273,13 @@ stmt
       }
       $$ = mkSTNode(While, t_None, $3, $5, NULL, NULL);
     }
-  | FOR '(' optional_assgt semicolon optional_boolexp semicolon optional_assgt ')' stmt {
+  | FOR '(' optional_assgt semicolon optional_boolexp semicolon
+    { if (share_exprs) ShareKill(); }   /* the body runs before the update */
+    optional_assgt ')' stmt {
       if ($5 != NULL && $5->etype != t_Bool && $5->etype != t_Error) {
         errmsg("conditional does not have Boolean type");
       }
-      $$ = mkSTNode(For, t_None, $3, $5, $7, $9);
+      $$ = mkSTNode(For, t_None, $3, $5, $8, $10);
     }
   | RETURN optional_expr semicolon {
       if (currFun->ret_type != t_None) {
@@ -276,8 +326,26 @@ comma
   | {errstate = NOCOMMA;} error 
   ;
 
+/*
+ * A block can start with declarations of its own locals, which are
+ * visible up to the closing brace.  The scope is ended by level rather
+ * than as the innermost one, since error recovery may have thrown away
+ * the closing brace of a block inside it.  Recovery from an error in the
+ * declarations stays inside the block, since "stmt : error" can follow
+ * them (see stmt_list); should the start of the block be thrown away all
+ * the same, as when the parse is given up, the %destructor for
+ * block_start ends the scope.  CleanupFnInfo() ends any scopes still
+ * open at the end of the function.
+ */
 compound_stmt
-  : '{' stmt_list '}' { $$ = $2; }
+  : block_start var_decls stmt_list '}' { 
+      SymTabExitScope($1); 
+      $$ = $3.head; 
+    }
+  ;
+
+block_start
+  : '{'  { $$ = SymTabEnterScope(); }
   ;
 
 optional_else
@@ -347,8 +415,7 @@ expr
   | '(' error ')'   { $$ = mkErrorNode(); }    
 | INTCON { $$ = mkConstNode(Intcon, t_Int, ival); }
 | CHARCON  { $$ = mkConstNode(Charcon, t_Char, ival); }
-| STRINGCON  { yytext[strlen(yytext)-1] = '\0'; /* to remove the trailing " */
-               $$ = mkStrNode(strdup(yytext+1)); }
+| STRINGCON  { $$ = mkStrNode(strval); }
   ;
 
 fun_call
@@ -388,11 +455,11 @@ fun_call
         errmsg("%s is not a function", $1);
       }
       else {
-	err_occurred = !ActualsMatchFormals(stptr, $3);
+	err_occurred = !ActualsMatchFormals(stptr, $3.head);
       }
 
       if (!err_occurred) {
-	$$ = mkSymTabRefNode(FunCall, stptr->ret_type, stptr, $3);
+	$$ = mkSymTabRefNode(FunCall, stptr->ret_type, stptr, $3.head);
       }
       else {
 	$$ = mkErrorNode();
@@ -451,11 +518,11 @@ proc_call
 	errmsg("non-VOID function %s used in a statement", $1);
       }
       else {
-	err_occurred = !ActualsMatchFormals(stptr, $3);
+	err_occurred = !ActualsMatchFormals(stptr, $3.head);
       }
 
       if (!err_occurred) {
-	$$ = mkSymTabRefNode(FunCall, stptr->ret_type, stptr, $3);
+	$$ = mkSymTabRefNode(FunCall, stptr->ret_type, stptr, $3.head);
       }
       else {
 	$$ = mkErrorNode();
@@ -524,8 +591,8 @@ variable
   ;
 
 expr_list 
-  : expr comma expr_list { $$ = mkListNode($1, $3); }
-  | expr     { $$ = mkListNode($1, NULL); }            
+  : expr_list comma expr { $$ = SeqAppend($1, $3); }
+  | expr     { $$ = SeqAppend((tnseq){NULL, NULL}, $1); }            
   ;
 
 Ident : ID { $$ = id_name; } ;
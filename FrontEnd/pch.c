@@ -0,0 +1,233 @@
+/*
+ * pch.c -- precompiled headers.
+ *
+ * "compile --precompile=OUT file" parses a file of prototypes and global
+ * declarations once (see Precompile() in compile.c) and writes its
+ * Global table to OUT with PchWrite(): a header, a record for each
+ * global and for each formal of a function, in the form used by AST
+ * files (astsym, see astfile.h), and the names.
+ *
+ * With -fpch=OUT, PchLoad() maps the image at startup and turns it into
+ * a table of atoms and a Global table of its own, once for the whole
+ * process; every compilation then starts with copies of these globals
+ * (SymTabSeedGlobal()), as if the file had come before it, without the
+ * file being scanned, parsed or its formals lists built again.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "global.h"
+#include "symbol-table.h"
+#include "syntax-tree.h"
+#include "astwrite.h"
+#include "pch.h"
+
+#define PCH_MAGIC      "C--PCH\n"    /* 8 bytes with the NUL */
+#define PCH_VERSION    1
+
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteorder;         /* AST_BYTEORDER */
+  uint32_t nsyms, nformals;
+  uint64_t syms, formals, strings;   /* offsets */
+  uint64_t stringsize;
+  uint64_t filesize;
+} pchheader;
+
+/*
+ * PchWrite(path) -- write the Global table of the calling thread to the
+ * file path.  Returns false, with a message on stderr, if the file can't
+ * be written, or if the table has a function definition: only the
+ * declarations of a header make sense in every file.
+ */
+bool PchWrite(char *path)
+{
+  pchheader hdr;
+  symtabnode **syms, *formal;
+  astsym *recs, *frecs;
+  char *strings;
+  size_t stringsize = 1, nf = 0;
+  int nsyms, i, j;
+  FILE *fp;
+  bool ok = true;
+
+  syms = SymTabGlobals(&nsyms);
+  for (i = 0; i < nsyms; i++) {
+    if (syms[i]->type == t_Func && syms[i]->fn_proto_state == FN_DEFINED) {
+      fprintf(stderr, "compile: %s: function %s is defined; only declarations "
+	      "can be precompiled\n", path, syms[i]->name);
+      ok = false;
+    }
+    stringsize += strlen(syms[i]->name) + 1;
+    for (formal = syms[i]->formals; formal != NULL; formal = formal->next) {
+      stringsize += strlen(formal->name) + 1;
+      nf++;
+    }
+  }
+  if (!ok) {
+    free(syms);
+    return false;
+  }
+
+  recs = zalloc((nsyms > 0 ? nsyms : 1) * sizeof(astsym));
+  frecs = zalloc((nf > 0 ? nf : 1) * sizeof(astsym));
+  strings = zalloc(stringsize);
+  stringsize = 1;            /* offset 0 is "" */
+  nf = 0;
+  for (i = 0; i < nsyms; i++) {
+    AstSymRecord(&recs[i], syms[i], stringsize);
+    stringsize += sprintf(strings + stringsize, "%s", syms[i]->name) + 1;
+    recs[i].formals = nf;
+    for (j = 0, formal = syms[i]->formals; formal != NULL; j++, formal = formal->next) {
+      AstSymRecord(&frecs[nf++], formal, stringsize);
+      stringsize += sprintf(strings + stringsize, "%s", formal->name) + 1;
+    }
+    recs[i].nformals = j;
+  }
+  free(syms);
+
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, PCH_MAGIC, sizeof(hdr.magic));
+  hdr.version = PCH_VERSION;
+  hdr.byteorder = AST_BYTEORDER;
+  hdr.nsyms = nsyms;
+  hdr.nformals = nf;
+  hdr.syms = sizeof(hdr);
+  hdr.formals = hdr.syms + nsyms * sizeof(astsym);
+  hdr.strings = hdr.formals + nf * sizeof(astsym);
+  hdr.stringsize = stringsize;
+  hdr.filesize = hdr.strings + stringsize;
+
+  ok = false;
+  if ((fp = fopen(path, "w")) != NULL) {
+    fwrite(&hdr, sizeof(hdr), 1, fp);
+    fwrite(recs, sizeof(astsym), nsyms, fp);
+    fwrite(frecs, sizeof(astsym), nf, fp);
+    fwrite(strings, 1, stringsize, fp);
+    ok = (ferror(fp) == 0);
+    ok = (fclose(fp) == 0 && ok);
+  }
+  if (!ok) {
+    fprintf(stderr, "compile: %s: %s\n", path, strerror(errno));
+  }
+
+  free(recs);
+  free(frecs);
+  free(strings);
+  return ok;
+}
+
+/*
+ * MakeSym(stptr, rec, name) -- fill in the symbol table entry stptr from
+ * the record rec, with the atom name.
+ */
+static void MakeSym(symtabnode *stptr, astsym *rec, char *name)
+{
+  stptr->name = name;
+  stptr->scope = rec->scope;
+  stptr->formal = rec->formal;
+  stptr->type = rec->type;
+  stptr->elt_type = rec->elt_type;
+  stptr->num_elts = rec->num_elts;
+  stptr->ret_type = rec->ret_type;
+  stptr->fn_proto_state = rec->fn_proto_state;
+  stptr->is_extern = rec->is_extern;
+  stptr->level = rec->level;
+}
+
+/*
+ * PchLoad(path, atoms, globals) -- load the precompiled header path,
+ * returning tables of its atoms and globals, which live as long as the
+ * process, in *atoms and *globals.  Returns false, with a message on
+ * stderr, if it can't be read or was not written by this compiler.
+ */
+bool PchLoad(char *path, struct atomtab **atoms, struct globaltab **globals)
+{
+  pchheader *hdr;
+  astsym *recs;
+  symtabnode *ents, **syms;
+  char *base, **names, *why = NULL;
+  struct stat st;
+  unsigned i, j, n;
+  int fd;
+
+  if ((fd = open(path, O_RDONLY)) < 0 || fstat(fd, &st) < 0) {
+    fprintf(stderr, "compile: %s: %s\n", path, strerror(errno));
+    if (fd >= 0) close(fd);
+    return false;
+  }
+  if (st.st_size < (off_t) sizeof(pchheader)) {
+    fprintf(stderr, "compile: %s: not a precompiled header\n", path);
+    close(fd);
+    return false;
+  }
+  base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    fprintf(stderr, "compile: %s: %s\n", path, strerror(errno));
+    return false;
+  }
+
+  hdr = (pchheader *) base;
+  recs = (astsym *) (base + sizeof(pchheader));
+  n = hdr->nsyms + hdr->nformals;
+  if (memcmp(hdr->magic, PCH_MAGIC, sizeof(hdr->magic)) != 0) {
+    why = "not a precompiled header";
+  }
+  else if (hdr->version != PCH_VERSION || hdr->byteorder != AST_BYTEORDER) {
+    why = "written by another version of the compiler";
+  }
+  else if (hdr->filesize != (uint64_t) st.st_size
+	   || hdr->syms != sizeof(pchheader)
+	   || hdr->formals != hdr->syms + (uint64_t) hdr->nsyms * sizeof(astsym)
+	   || hdr->strings != hdr->formals + (uint64_t) hdr->nformals * sizeof(astsym)
+	   || hdr->strings + hdr->stringsize != hdr->filesize
+	   || hdr->stringsize == 0
+	   || base[hdr->filesize - 1] != '\0') {
+    why = "truncated or damaged";
+  }
+  for (i = 0; i < n && why == NULL; i++) {
+    if (recs[i].name >= hdr->stringsize
+	|| (i < hdr->nsyms
+	    && recs[i].formals + (uint64_t) recs[i].nformals > hdr->nformals)) {
+      why = "truncated or damaged";
+    }
+  }
+  if (why != NULL) {
+    fprintf(stderr, "compile: %s: %s\n", path, why);
+    munmap(base, st.st_size);
+    return false;
+  }
+
+  /*
+   * The globals come first in ents, then the formals.
+   */
+  names = zalloc((n > 0 ? n : 1) * sizeof(char *));
+  for (i = 0; i < n; i++) {
+    names[i] = base + hdr->strings + recs[i].name;
+  }
+  *atoms = AtomTabMake(names, n);
+
+  ents = zalloc((n > 0 ? n : 1) * sizeof(symtabnode));
+  syms = zalloc((hdr->nsyms > 0 ? hdr->nsyms : 1) * sizeof(symtabnode *));
+  for (i = 0; i < n; i++) {
+    MakeSym(&ents[i], &recs[i], names[i]);
+  }
+  for (i = 0; i < hdr->nsyms; i++) {
+    for (j = recs[i].nformals; j > 0; j--) {
+      ents[hdr->nsyms + recs[i].formals + j-1].next = ents[i].formals;
+      ents[i].formals = &ents[hdr->nsyms + recs[i].formals + j-1];
+    }
+    syms[i] = &ents[i];
+  }
+  *globals = SymTabMakeGlobal(syms, hdr->nsyms);
+
+  free(syms);
+  free(names);
+  munmap(base, st.st_size);
+  return true;
+}
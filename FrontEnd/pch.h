@@ -0,0 +1,15 @@
+/*
+ * pch.h -- precompiled headers: images of the Global table after a file
+ * of prototypes and extern declarations.
+ */
+
+#ifndef _PCH_H_
+#define _PCH_H_
+
+struct atomtab;
+struct globaltab;
+
+bool PchWrite(char *path);
+bool PchLoad(char *path, struct atomtab **atoms, struct globaltab **globals);
+
+#endif  /* _PCH_H_ */
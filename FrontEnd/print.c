@@ -8,41 +8,66 @@
 #include "global.h"
 #include "protos.h"
 #include "syntax-tree.h"
+#include "output.h"
+#include "walk.h"
 
 static void indent(int n);
+static void printDepth(int depth);
 static void printBinop(int op);
 static void printUnop(int op);
+static walkaction printHead(walkframe *f);
+static walkaction printLabel(walkframe *f);
+static walkaction printEnd(walkframe *f);
+static walkaction printNull(walkframe *f);
 
  
 
-extern int ErrorNum;
-extern int IntconNum;
-extern int CharconNum;
-extern int StringconNum;
-extern int VarNum;
-extern int ArraySubscriptNum;
-extern int PlusNum;
-extern int UnaryMinusNum;
-extern int BinaryMinusNum;
-extern int MultNum;
-extern int DivNum;
-extern int EqualsNum;
-extern int NeqNum;
-extern int LeqNum;
-extern int LtNum;
-extern int GeqNum;
-extern int GtNum;
-extern int LogicalAndNum;
-extern int LogicalOrNum;
-extern int LogicalNotNum;
-extern int FunCallNum;
-extern int AssgNum;
-extern int ReturnNum;
-extern int ForNum;
-extern int WhileNum;
-extern int IfNum;
-extern int STnodeListNum;
-
+/*
+ * The printer: each node starts a line with its depth, indentation and
+ * head, printed by printHead(), which also sets the indentation of its
+ * children (kidarg); some children are preceded by a label line (KidLabel),
+ * and some nodes are closed by a line of their own (EndLabel).
+ */
+static const walker TreePrinter = {
+  .pre = { [Error ... STnodeList] = printHead },
+  .child = { [FunCall] = printLabel, [Assg] = printLabel, [For] = printLabel,
+	     [While] = printLabel, [If] = printLabel },
+  .post = { [ArraySubscript] = printEnd,
+	    [Plus] = printEnd, [UnaryMinus] = printEnd, [BinaryMinus] = printEnd,
+	    [Mult] = printEnd, [Div] = printEnd, [Equals] = printEnd,
+	    [Neq] = printEnd, [Leq] = printEnd, [Lt] = printEnd, [Geq] = printEnd,
+	    [Gt] = printEnd, [LogicalAnd] = printEnd, [LogicalOr] = printEnd,
+	    [LogicalNot] = printEnd, [For] = printEnd, [While] = printEnd,
+	    [If] = printEnd, [STnodeList] = printEnd },
+  .null = printNull,
+};
+
+static const unsigned char KidIndent[NNODETYPES] = {
+  [ArraySubscript] = 9,
+  [Plus] = 2, [UnaryMinus] = 2, [BinaryMinus] = 2, [Mult] = 2, [Div] = 2,
+  [Equals] = 2, [Neq] = 2, [Leq] = 2, [Lt] = 2, [Geq] = 2, [Gt] = 2,
+  [LogicalAnd] = 2, [LogicalOr] = 2, [LogicalNot] = 2,
+  [FunCall] = 4, [Assg] = 4, [Return] = 2,
+  [For] = 4, [While] = 4, [If] = 4, [STnodeList] = 2,
+};
+
+static char *KidLabel[NNODETYPES][4] = {
+  [FunCall] = { "  args:\n" },
+  [Assg] = { "  Lhs:\n", "  Rhs:\n" },
+  [For] = { "  init:\n", "  test:\n", "  update:\n", "  body:\n" },
+  [While] = { NULL, "  body:\n " },
+  [If] = { NULL, "  then:\n", "  else:\n" },
+};
+
+static char *EndLabel[NNODETYPES] = {
+  [ArraySubscript] = ")\n",
+  [Plus] = ")\n", [UnaryMinus] = ")\n", [BinaryMinus] = ")\n", [Mult] = ")\n",
+  [Div] = ")\n", [Equals] = ")\n", [Neq] = ")\n", [Leq] = ")\n", [Lt] = ")\n",
+  [Geq] = ")\n", [Gt] = ")\n", [LogicalAnd] = ")\n", [LogicalOr] = ")\n",
+  [LogicalNot] = ")\n",
+  [For] = "ENDFOR\n", [While] = "ENDWHILE\n", [If] = "ENDIF\n",
+  [STnodeList] = "}\n",
+};
 
 /*
  * printSyntaxTree(t,n) -- print out a syntax tree.  t is a pointer
@@ -52,175 +77,132 @@ extern int STnodeListNum;
  */
 void printSyntaxTree(tnode *t, int n, int depth)
 {
-  symtabnode *stptr;
-  tnode *tntmp0;
+  WalkTree(&TreePrinter, t, depth, n);
+}
 
-  printf("%d:", depth);
-  indent(n);
+static walkaction printHead(walkframe *f)
+{
+  tnode *t = f->t;
+  symtabnode *stptr;
 
-  if (t == NULL) {
-    printf("-null-\n");
-    return;
-  }
+  printDepth(f->depth);
+  indent(f->arg);
+  f->kidarg = f->arg + KidIndent[t->ntype];
 
   switch (t->ntype) {
   case Error:
-    printf("-error-\n");
+    OutStr("-error-\n");
     break;
 
   case Intcon:
-    printf("intcon(%d);\n", stIntcon(t));
+    OutStr("intcon(");
+    OutInt(stIntcon(t));
+    OutStr(");\n");
     break;
 
   case Charcon:
-    printf("charcon(%d);\n", stCharcon(t));
+    OutStr("charcon(");
+    OutInt(stCharcon(t));
+    OutStr(");\n");
     break;
 
   case Stringcon:
-    printf("str(%s);\n", stStringcon(t));
+    OutStr("str(");
+    OutStr(stStringcon(t));
+    OutStr(");\n");
     break;
 
   case Var:
     stptr = stVar(t);
-    printf("id(name=%s, scope=%s);\n", 
-	   stptr->name,
-	   (stptr->scope == Global ? "G" : "L"));
+    OutStr("id(name=");
+    OutStr(stptr->name);
+    OutStr(stptr->scope == Global ? ", scope=G);\n" : ", scope=L);\n");
     break;
 
   case ArraySubscript:
     stptr = stArraySubscript_Array(t);
-    printf("arrayRef(id(name=%s, scope=%s),\n",
-	   stptr->name,
-	   (stptr->scope == Global ? "G" : "L"));
-    printSyntaxTree(stArraySubscript_Subscript(t), n+9, depth+1);
-    printf("%d:", depth);
-    indent(n+8);
-    printf(")\n");
+    OutStr("arrayRef(id(name=");
+    OutStr(stptr->name);
+    OutStr(stptr->scope == Global ? ", scope=G),\n" : ", scope=L),\n");
     break;
 
   case UnaryMinus:
   case LogicalNot:
     printUnop(t->ntype);
-    printf("(\n");
-    printSyntaxTree(stUnop_Op(t), n+2, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf(")\n");
-    break;
-
-  case Plus:
-  case BinaryMinus:
-  case Mult:
-  case Div:
-  case Equals:
-  case Neq:
-  case Leq:
-  case Lt:
-  case Geq:
-  case Gt:
-  case LogicalAnd:
-  case LogicalOr:
-    printBinop(t->ntype);
-    printf("(\n");
-    printSyntaxTree(stBinop_Op1(t), n+2, depth+1);
-    printSyntaxTree(stBinop_Op2(t), n+2, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf(")\n");
+    OutStr("(\n");
     break;
 
   case FunCall:
     stptr = stFunCall_Fun(t);
-    printf("CALL: callee=%s\n", stptr->name);
-    printf("%d:", depth);
-    indent(n);
-    printf("  args:\n");
-    printSyntaxTree(stFunCall_Args(t), n+4, depth+1);
+    OutStr("CALL: callee=");
+    OutStr(stptr->name);
+    OutChar('\n');
     break;
 
   case Assg:
-    printf("ASSG:\n");
-    printf("%d:", depth);
-    indent(n);
-    printf("  Lhs:\n");
-    printSyntaxTree(stAssg_Lhs(t), n+4, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf("  Rhs:\n");
-    printSyntaxTree(stAssg_Rhs(t), n+4, depth+1);
+    OutStr("ASSG:\n");
     break;
 
   case Return:
-    printf("RETURN:\n");
-    printSyntaxTree(stReturn(t), n+2, depth+1);
+    OutStr("RETURN:\n");
     break;
 
   case For:
-    printf("FOR\n");
-    printf("%d:", depth);
-    indent(n);
-    printf("  init:\n");
-    printSyntaxTree(stFor_Init(t), n+4, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf("  test:\n");
-    printSyntaxTree(stFor_Test(t), n+4, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf("  update:\n");
-    printSyntaxTree(stFor_Update(t), n+4, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf("  body:\n");
-    printSyntaxTree(stFor_Body(t), n+4, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf("ENDFOR\n");
+    OutStr("FOR\n");
     break;
 
   case While:
-    printf("WHILE\n");
-    printSyntaxTree(stWhile_Test(t), n+4, depth+1);
-    printf("%d:", depth);
-    printf("  body:\n ");
-    printSyntaxTree(stWhile_Body(t), n+4, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf("ENDWHILE\n");
+    OutStr("WHILE\n");
     break;
 
   case If:
-    printf("IF\n");
-    printSyntaxTree(stIf_Test(t), n+4, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf("  then:\n");
-    printSyntaxTree(stIf_Then(t), n+4, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf("  else:\n");
-    printSyntaxTree(stIf_Else(t), n+4, depth+1);
-    printf("%d:", depth);
-    indent(n);
-    printf("ENDIF\n");
+    OutStr("IF\n");
     break;
 
   case STnodeList:  /* list of syntax tree nodes */
-    printf("{\n");
-    /* iterate down the list, printing out each tree in the list in turn */
-    for (tntmp0 = t; tntmp0 != NULL; tntmp0 = stList_Rest(tntmp0)) {
-      printSyntaxTree(stList_Head(tntmp0),n+2, depth+1);
-    }
-    printf("%d:", depth);
-    indent(n);
-    printf("}\n");
+    OutStr("{\n");
     break;
 
-  default:
-    fprintf(stderr, "Unknown syntax tree node type %d\n", t->ntype);
+  default:  /* binary operators */
+    printBinop(t->ntype);
+    OutStr("(\n");
   }
 
-  return;
+  return WALK_CONTINUE;
+}
+
+/*
+ * printLabel(f) -- print the label, if any, of the next child.  That of
+ * the body of a while loop is not indented.
+ */
+static walkaction printLabel(walkframe *f)
+{
+  char *label = KidLabel[f->t->ntype][f->kid];
+
+  if (label != NULL) {
+    printDepth(f->depth);
+    if (f->t->ntype != While) {
+      indent(f->arg);
+    }
+    OutStr(label);
+  }
+  return WALK_CONTINUE;
+}
+
+static walkaction printEnd(walkframe *f)
+{
+  printDepth(f->depth);
+  indent(f->t->ntype == ArraySubscript ? f->arg + 8 : f->arg);
+  OutStr(EndLabel[f->t->ntype]);
+  return WALK_CONTINUE;
+}
+
+static walkaction printNull(walkframe *f)
+{
+  printDepth(f->depth);
+  indent(f->arg);
+  OutStr("-null-\n");
+  return WALK_CONTINUE;
 }
 
 /*
@@ -228,11 +210,16 @@ void printSyntaxTree(tnode *t, int n, int depth)
  */
 static void indent(int n)
 {
-  if (n < 0) return;
+  OutSpaces(n);
+}
 
-  while (n-- > 0) {
-    putc(' ', stdout);
-  }  
+/*
+ * printDepth(depth) -- print the depth at the start of a line.
+ */
+static void printDepth(int depth)
+{
+  OutInt(depth);
+  OutChar(':');
 }
 
 /*
@@ -242,40 +229,40 @@ static void printBinop(int op)
 {
   switch (op) {
   case Plus:
-    putc('+', stdout);
+    OutChar('+');
     break;
   case BinaryMinus:
-    putc('-', stdout);
+    OutChar('-');
     break;
   case Mult:
-    putc('*', stdout);
+    OutChar('*');
     break;
   case Div:
-    putc('/', stdout);
+    OutChar('/');
     break;
   case Equals:
-    printf("==");
+    OutStr("==");
     break;
   case Neq:
-    printf("!=");
+    OutStr("!=");
     break;
   case Leq:
-    printf("<=");
+    OutStr("<=");
     break;
   case Lt:
-    putc('<', stdout);
+    OutChar('<');
     break;
   case Geq:
-    printf(">=");
+    OutStr(">=");
     break;
   case Gt:
-    putc('>', stdout);
+    OutChar('>');
     break;
   case LogicalAnd:
-    printf("&&");
+    OutStr("&&");
     break;
   case LogicalOr:
-    printf("||");
+    OutStr("||");
     break;
   }
 
@@ -289,349 +276,13 @@ static void printUnop(int op)
 {
   switch (op) {
   case UnaryMinus:
-    putc('-', stdout);
+    OutChar('-');
     break;
     
   case LogicalNot:
-    putc('!', stdout);
-    break;
-  }
-
-  return;
-}
-
-
-/*
-HW0, this function counts the variable and functioncall
-*/
-void printNode(tnode *t, int n, int depth)
-{
-
-
-
-  symtabnode *stptr;
-  tnode *tntmp0;
-
-  //printf("%d:", depth);
-  //indent(n);
-
-  if (t == NULL) {
-    //printf("-null-\n");
-    return;
-  }
-
-  switch (t->ntype) {
-  case Error:
-    ErrorNum++;
-    // printf("Error:%d", EqualsNum);
-    //printf("-error-\n%d",ErrorNum);
-    break;
-
-  case Intcon:
-    IntconNum++;
-    //printf("intcon(%d);\n", stIntcon(t));
-    break;
-
-  case Charcon:
-    CharconNum++;
-    //printf("charcon(%d);\n", stCharcon(t));
-    break;
-
-  case Stringcon:
-    StringconNum++;
-    //printf("str(%s);\n", stStringcon(t));
-    break;
-
-  case Var:
-    VarNum++;
-    stptr = stVar(t);
-    //printf("id(name=%s, scope=%s);\n", stptr->name,(stptr->scope == Global ? "G" : "L"));
-    break;
-
-  case ArraySubscript:
-    ArraySubscriptNum++;
-    stptr = stArraySubscript_Array(t);
-    //printf("arrayRef(id(name=%s, scope=%s),\n",stptr->name,(stptr->scope == Global ? "G" : "L"));
-    printNode(stArraySubscript_Subscript(t), n+9, depth+1);
-    //printf("%d:", depth);
-    //indent(n+8);
-    //printf(")\n");
-    break;
-
-  case UnaryMinus:
-    UnaryMinusNum++;
-    break;
-
-  case LogicalNot:
-    LogicalNotNum++;
-    //printUnop(t->ntype);
-    //printf("(\n");
-    printNode(stUnop_Op(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case Plus:
-    PlusNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case BinaryMinus:
-    BinaryMinusNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case Mult:
-    MultNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case Div:
-    DivNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case Equals:
-    EqualsNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case Neq:
-    NeqNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case Leq:
-    LeqNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case Lt:
-    LtNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case Geq:
-    GeqNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case Gt:
-    GtNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
+    OutChar('!');
     break;
-
-  case LogicalAnd:
-    LogicalAndNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case LogicalOr:
-    LogicalOrNum++;
-    //printBinop(t->ntype);
-    //printf("(\n");
-    printNode(stBinop_Op1(t), n+2, depth+1);
-    printNode(stBinop_Op2(t), n+2, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf(")\n");
-    break;
-
-  case FunCall:
-    FunCallNum++;
-    stptr = stFunCall_Fun(t);
-    //printf("CALL: callee=%s\n", stptr->name);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf("  args:\n");
-    printNode(stFunCall_Args(t), n+4, depth+1);
-    break;
-
-  case Assg:
-    AssgNum++;
-    //printf("ASSG:\n");
-    //printf("%d:", depth);
-    //indent(n);
-    //printf("  Lhs:\n");
-    printNode(stAssg_Lhs(t), n+4, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf("  Rhs:\n");
-    printNode(stAssg_Rhs(t), n+4, depth+1);
-    break;
-
-  case Return:
-    ReturnNum++;
-    //printf("RETURN:\n");
-    printNode(stReturn(t), n+2, depth+1);
-    break;
-
-  case For:
-    ForNum++;
-    //printf("FOR\n");
-    //printf("%d:", depth);
-    //indent(n);
-    //printf("  init:\n");
-    printNode(stFor_Init(t), n+4, depth+1);
-    // printf("%d:", depth);
-    // indent(n);
-    // printf("  test:\n");
-    printNode(stFor_Test(t), n+4, depth+1);
-    // printf("%d:", depth);
-    // indent(n);
-    // printf("  update:\n");
-    printNode(stFor_Update(t), n+4, depth+1);
-    // printf("%d:", depth);
-    // indent(n);
-    // printf("  body:\n");
-    printNode(stFor_Body(t), n+4, depth+1);
-    // printf("%d:", depth);
-    // indent(n);
-    //printf("ENDFOR\n");
-    break;
-
-  case While:
-    WhileNum++;
-    //printf("WHILE\n");
-    printNode(stWhile_Test(t), n+4, depth+1);
-    //printf("%d:", depth);
-    //printf("  body:\n ");
-    printNode(stWhile_Body(t), n+4, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf("ENDWHILE\n");
-    break;
-
-  case If:
-    IfNum++;
-    //printf("IF\n");
-    printNode(stIf_Test(t), n+4, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf("  then:\n");
-    printNode(stIf_Then(t), n+4, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf("  else:\n");
-    printNode(stIf_Else(t), n+4, depth+1);
-    //printf("%d:", depth);
-    //indent(n);
-    //printf("ENDIF\n");
-    break;
-
-  case STnodeList:  /* list of syntax tree nodes */
-    STnodeListNum++;
-    //printf("{\n");
-    /* iterate down the list, printing out each tree in the list in turn */
-    for (tntmp0 = t; tntmp0 != NULL; tntmp0 = stList_Rest(tntmp0)) {
-      printNode(stList_Head(tntmp0),n+2, depth+1);
-    }
-    //printf("%d:", depth);
-    //indent(n);
-    //printf("}\n");
-    break;
-
-  //default:
-    //fprintf(stderr, "Unknown syntax tree node type %d\n", t->ntype);
   }
 
-  
-  
   return;
-
-  // Error,
-  // Intcon,
-  // Charcon,
-  // Stringcon,
-  // Var,
-  // ArraySubscript,
-  // Plus,
-  // UnaryMinus,
-  // BinaryMinus,
-  // Mult,
-  // Div,
-  // Equals,
-  // Neq,
-  // Leq,
-  // Lt,
-  // Geq,
-  // Gt,
-  // LogicalAnd,
-  // LogicalOr,
-  // LogicalNot,
-  // FunCall,
-  // Assg,
-  // Return,
-  // For,
-  // While,
-  // If,
-  // STnodeList
-
 }
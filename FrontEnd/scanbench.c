@@ -0,0 +1,72 @@
+/*
+ * scanbench.c -- measure the speed of the scanner.
+ *
+ * Usage: scanbench file [reps]
+ *
+ * Reads file into memory once, then runs yylex() over it reps times
+ * (default 20) and reports the number of tokens scanned per second.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+#include "global.h"
+
+extern int yylex();
+extern void yyrestart(FILE *fp);
+
+static double now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+  FILE *fp;
+  char *buf;
+  long len, ntoks = 0;
+  int i, reps = 20;
+  double t0, t1;
+
+  outfp = stdout;
+  errfp = stderr;
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s file [reps]\n", argv[0]);
+    return 1;
+  }
+  if (argc > 2) {
+    reps = atoi(argv[2]);
+  }
+
+  if ((fp = fopen(argv[1], "r")) == NULL) {
+    perror(argv[1]);
+    return 1;
+  }
+  fseek(fp, 0, SEEK_END);
+  len = ftell(fp);
+  rewind(fp);
+  buf = zalloc(len + 1);
+  if (fread(buf, 1, len, fp) != (size_t) len) {
+    perror(argv[1]);
+    return 1;
+  }
+  fclose(fp);
+
+  t0 = now();
+  for (i = 0; i < reps; i++) {
+    fp = fmemopen(buf, len, "r");
+    yyrestart(fp);
+    while (yylex() != 0) {
+      ntoks++;
+    }
+    fclose(fp);
+  }
+  t1 = now();
+
+  printf("%ld tokens in %.3f sec: %.0f tokens/sec\n",
+	 ntoks, t1 - t0, ntoks / (t1 - t0));
+
+  return 0;
+}
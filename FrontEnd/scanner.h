@@ -0,0 +1,33 @@
+/*
+ * scanner.h -- the interface to the scanner: either the one generated
+ * by flex from scanner.l, or the hand-written one in simdscan.c.
+ */
+
+#ifndef _SCANNER_H_
+#define _SCANNER_H_
+
+extern THREAD_LOCAL char *id_name;       /* see README */
+extern THREAD_LOCAL char *strval;
+extern THREAD_LOCAL int ival;
+extern THREAD_LOCAL int linenum;
+extern THREAD_LOCAL bool scan_in_place;
+
+/*
+ * scanner_thread_safe is true if all of the scanner's state is
+ * thread-local, so that several threads can each be scanning a file.
+ * This is not the case for the flex scanner, whose buffers are kept in
+ * static variables of the generated code.  Neither scanner is reentrant
+ * in the sense of taking its state as an argument; a thread can only be
+ * scanning one file at a time.
+ */
+extern const bool scanner_thread_safe;
+
+struct yy_buffer_state;
+
+int yylex(void);
+void yyrestart(FILE *fp);
+struct yy_buffer_state *yy_scan_buffer(char *base, size_t size);
+int yylex_destroy(void);
+char *ScanText(void);
+
+#endif  /* _SCANNER_H_ */
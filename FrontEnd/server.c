@@ -0,0 +1,417 @@
+/*
+ * server.c -- a resident compile server on a Unix domain socket, and
+ * its client.
+ *
+ * compile --server=SOCKET keeps running and compiles whatever source
+ * text clients send it.  Each of its worker threads compiles one request
+ * at a time, keeping its memory from one request to the next (see
+ * CompileResident()), and starting each one with the globals of the
+ * prelude file given with --preload, which is parsed once at startup.
+ *
+ * A client connects, sends one request and reads one reply; all numbers
+ * are 32 bits in network byte order:
+ *
+ *	request:  length, source text
+ *	reply:    exit status, length, output, length, error messages
+ *
+ * compile --client=SOCKET [file] sends the file or stdin, and writes the
+ * output to stdout and the error messages to stderr, so that it can
+ * stand in for a compilation on the spot.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "global.h"
+#include "scanner.h"
+#include "compile.h"
+#include "server.h"
+
+#define MAXREQUEST  (256*1024*1024)   /* max. size of a source text */
+
+static int ListenFd = -1;
+static char *SockPath;
+
+/*********************************************************************
+ *                                                                   *
+ *                            SOCKET I/O                             *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * ReadFull(fd, buf, n) -- read exactly n bytes from fd into buf.
+ * Returns false on error or end of file.
+ */
+static bool ReadFull(int fd, void *buf, size_t n)
+{
+  char *p = buf;
+  ssize_t k;
+
+  while (n > 0) {
+    if ((k = read(fd, p, n)) < 0 && errno == EINTR) {
+      continue;
+    }
+    if (k <= 0) {
+      return false;
+    }
+    p += k;
+    n -= k;
+  }
+
+  return true;
+}
+
+/*
+ * WriteFull(fd, buf, n) -- write the n bytes at buf to the socket fd.  A
+ * client that goes away must not kill the server with SIGPIPE.  Returns
+ * false on error.
+ */
+static bool WriteFull(int fd, void *buf, size_t n)
+{
+  char *p = buf;
+  ssize_t k;
+
+  while (n > 0) {
+    if ((k = send(fd, p, n, MSG_NOSIGNAL)) < 0 && errno == EINTR) {
+      continue;
+    }
+    if (k <= 0) {
+      return false;
+    }
+    p += k;
+    n -= k;
+  }
+
+  return true;
+}
+
+/*
+ * ReadNum(fd, np), WriteNum(fd, n) -- read or write one number.
+ */
+static bool ReadNum(int fd, uint32_t *np)
+{
+  if (!ReadFull(fd, np, sizeof(*np))) {
+    return false;
+  }
+  *np = ntohl(*np);
+  return true;
+}
+
+static bool WriteNum(int fd, uint32_t n)
+{
+  n = htonl(n);
+  return WriteFull(fd, &n, sizeof(n));
+}
+
+/*
+ * ReadAll(fd, lenp) -- read fd up to end of file, into a buffer with two
+ * NUL bytes after the *lenp bytes read.  Returns NULL on error.
+ */
+static char *ReadAll(int fd, size_t *lenp)
+{
+  size_t len = 0, size = 64*1024;
+  char *buf = malloc(size), *nbuf;
+  ssize_t k;
+
+  for (;;) {
+    if (buf == NULL) {
+      fprintf(stderr, "Not enough memory\n");
+      abort();
+    }
+    if ((k = read(fd, buf + len, size - len - 2)) < 0 && errno == EINTR) {
+      continue;
+    }
+    if (k < 0) {
+      free(buf);
+      return NULL;
+    }
+    if (k == 0) {
+      break;
+    }
+    len += k;
+    if (size - len - 2 == 0) {
+      size *= 2;
+      if ((nbuf = realloc(buf, size)) == NULL) {
+	free(buf);
+      }
+      buf = nbuf;
+    }
+  }
+
+  buf[len] = buf[len+1] = '\0';
+  *lenp = len;
+  return buf;
+}
+
+/*
+ * SocketAddr(path, sa) -- fill in sa for the socket path.  Returns false
+ * if the path is too long.
+ */
+static bool SocketAddr(char *path, struct sockaddr_un *sa)
+{
+  memset(sa, 0, sizeof(*sa));
+  sa->sun_family = AF_UNIX;
+  if (strlen(path) >= sizeof(sa->sun_path)) {
+    fprintf(stderr, "compile: socket path too long: %s\n", path);
+    return false;
+  }
+  strcpy(sa->sun_path, path);
+  return true;
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                              SERVER                               *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * Serve(fd) -- read one request from the connection fd, compile it, and
+ * send back the reply.
+ */
+static void Serve(int fd)
+{
+  uint32_t len;
+  char *buf, *out = NULL, *err = NULL;
+  size_t outlen = 0, errlen = 0;
+  FILE *outf, *errf;
+  int status;
+
+  if (!ReadNum(fd, &len) || len > MAXREQUEST) {
+    return;
+  }
+  if ((buf = malloc(len + 2)) == NULL) {
+    fprintf(stderr, "Not enough memory\n");
+    abort();
+  }
+  if (!ReadFull(fd, buf, len)) {
+    free(buf);
+    return;
+  }
+  buf[len] = buf[len+1] = '\0';
+
+  outf = open_memstream(&out, &outlen);
+  errf = open_memstream(&err, &errlen);
+  if (outf == NULL || errf == NULL) {
+    fprintf(stderr, "Not enough memory\n");
+    abort();
+  }
+  status = CompileBuffer(buf, len, outf, errf);
+  fclose(outf);
+  fclose(errf);
+  free(buf);
+
+  (void) (WriteNum(fd, status)
+	  && WriteNum(fd, outlen) && WriteFull(fd, out, outlen)
+	  && WriteNum(fd, errlen) && WriteFull(fd, err, errlen));
+  free(out);
+  free(err);
+}
+
+/*
+ * ServeWorker(arg) -- take connections and serve them, one at a time,
+ * with the prelude arg.
+ */
+static void *ServeWorker(void *arg)
+{
+  int fd;
+
+  CompileResident(arg);
+  for (;;) {
+    if ((fd = accept(ListenFd, NULL, NULL)) < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+	continue;
+      }
+      perror("compile: accept");
+      return NULL;
+    }
+    Serve(fd);
+    close(fd);
+  }
+}
+
+/*
+ * Shutdown(sig) -- remove the socket on the way out.
+ */
+static void Shutdown(int sig)
+{
+  unlink(SockPath);
+  _exit(0);
+}
+
+/*
+ * Listen(path) -- create the socket path and listen on it.  A socket
+ * left behind by a server that is gone is removed first.  Returns false
+ * if the socket can't be set up.
+ */
+static bool Listen(char *path)
+{
+  struct sockaddr_un sa;
+  struct stat st;
+  int fd;
+
+  if (!SocketAddr(path, &sa)) {
+    return false;
+  }
+
+  if (stat(path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr *) &sa, sizeof(sa)) == 0) {
+      fprintf(stderr, "compile: a server is already running on %s\n", path);
+      close(fd);
+      return false;
+    }
+    if (fd >= 0) close(fd);
+    unlink(path);
+  }
+
+  if ((ListenFd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0
+      || bind(ListenFd, (struct sockaddr *) &sa, sizeof(sa)) < 0
+      || listen(ListenFd, SOMAXCONN) < 0) {
+    fprintf(stderr, "compile: %s: %s\n", path, strerror(errno));
+    return false;
+  }
+
+  return true;
+}
+
+/*
+ * ServerMain(sockpath, prelude, nworkers) -- load the prelude file, if
+ * not NULL, and serve compilation requests on the socket sockpath with
+ * nworkers threads until killed.  Returns only if the server can't be
+ * started, with the exit status.
+ */
+int ServerMain(char *sockpath, char *prelude, int nworkers)
+{
+  struct prelude *p = NULL;
+  pthread_t *tids;
+  int i;
+
+  if (nworkers > 1 && !scanner_thread_safe) {
+    fprintf(stderr, "compile: -j needs the thread-safe scanner "
+	    "(make SCANNER=simdscan); using one thread\n");
+    nworkers = 1;
+  }
+
+  if (prelude != NULL && (p = LoadPrelude(prelude, stderr)) == NULL) {
+    fprintf(stderr, "compile: can't load prelude %s\n", prelude);
+    return 1;
+  }
+  if (!Listen(sockpath)) {
+    return 1;
+  }
+  SockPath = sockpath;
+  signal(SIGINT, Shutdown);
+  signal(SIGTERM, Shutdown);
+
+  fprintf(stderr, "compile: serving on %s, %d threads\n", sockpath, nworkers);
+
+  tids = zalloc(nworkers * sizeof(pthread_t));
+  for (i = 0; i < nworkers; i++) {
+    if (pthread_create(&tids[i], NULL, ServeWorker, p) != 0) {
+      fprintf(stderr, "compile: can't create server thread\n");
+      abort();
+    }
+  }
+  for (i = 0; i < nworkers; i++) {
+    pthread_join(tids[i], NULL);
+  }
+  free(tids);
+
+  unlink(sockpath);
+  return 1;
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                              CLIENT                               *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * CopyText(fd, fp) -- read one length and text from fd, and write the
+ * text to fp.  Returns false on error.
+ */
+static bool CopyText(int fd, FILE *fp)
+{
+  char buf[BUFSIZ];
+  uint32_t n;
+  size_t k;
+
+  if (!ReadNum(fd, &n)) {
+    return false;
+  }
+  while (n > 0) {
+    k = (n < sizeof(buf) ? n : sizeof(buf));
+    if (!ReadFull(fd, buf, k)) {
+      return false;
+    }
+    fwrite(buf, 1, k, fp);
+    n -= k;
+  }
+  fflush(fp);
+
+  return true;
+}
+
+/*
+ * ClientCompile(sockpath, path, quiet, status) -- have the server on
+ * sockpath compile the file path, or stdin if path is NULL, and write
+ * its output and error messages to stdout and stderr.  The exit status
+ * for the compilation goes in *status.  Returns false, without reading
+ * the input, if there is no server to connect to; the reason is given
+ * on stderr unless quiet is set.
+ */
+bool ClientCompile(char *sockpath, char *path, bool quiet, int *status)
+{
+  struct sockaddr_un sa;
+  int fd, infd = 0;
+  char *buf;
+  size_t len;
+  uint32_t st;
+  bool ok;
+
+  if (!SocketAddr(sockpath, &sa)) {
+    return false;
+  }
+  if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0
+      || connect(fd, (struct sockaddr *) &sa, sizeof(sa)) < 0) {
+    if (!quiet) {
+      fprintf(stderr, "compile: %s: %s\n", sockpath, strerror(errno));
+    }
+    if (fd >= 0) close(fd);
+    return false;
+  }
+
+  if ((path != NULL && (infd = open(path, O_RDONLY)) < 0)
+      || (buf = ReadAll(infd, &len)) == NULL) {
+    fprintf(stderr, "%s: %s\n", (path != NULL ? path : "stdin"), strerror(errno));
+    if (path != NULL && infd >= 0) close(infd);
+    close(fd);
+    *status = 1;
+    return true;
+  }
+  if (path != NULL) {
+    close(infd);
+  }
+
+  ok = (WriteNum(fd, len) && WriteFull(fd, buf, len) && ReadNum(fd, &st)
+	&& CopyText(fd, stdout) && CopyText(fd, stderr));
+  free(buf);
+  close(fd);
+
+  if (!ok) {
+    fprintf(stderr, "compile: %s: lost the connection to the server\n", sockpath);
+    *status = 1;
+  }
+  else {
+    *status = (int32_t) st;
+  }
+  return true;
+}
@@ -0,0 +1,12 @@
+/*
+ * server.h -- a resident compile server on a Unix domain socket, and
+ * its client.
+ */
+
+#ifndef _SERVER_H_
+#define _SERVER_H_
+
+int ServerMain(char *sockpath, char *prelude, int nworkers);
+bool ClientCompile(char *sockpath, char *path, bool quiet, int *status);
+
+#endif  /* _SERVER_H_ */
@@ -0,0 +1,455 @@
+/*
+ * simdscan.c -- a hand-written scanner for C--.
+ *
+ * This is a drop-in replacement for the flex scanner generated from
+ * scanner.l: it returns the same tokens and sets the same globals
+ * (yytext, yyleng, id_name, strval, ival, linenum).  It is selected at
+ * build time with "make SCANNER=simdscan".
+ *
+ * The whole input is kept in one buffer: either the file mapped by
+ * MapInput() in compile.c (via yy_scan_buffer()) or a copy of stdin.  Runs of
+ * white space, comment bodies and identifiers are scanned VECLEN bytes at a
+ * time with AVX2 or SSE2 when the compiler targets them (e.g. with -mavx2),
+ * and a byte at a time otherwise.  Vector loads never go past the end of
+ * the buffer; the last few bytes are always handled by the scalar code.
+ *
+ * Use "make scancheck CORPUS='files...'" to check that this scanner and
+ * the flex scanner produce the same tokens.
+ */
+
+#include <ctype.h>
+#include "global.h"
+#include "syntax-tree.h"
+#include "y.tab.h"
+#include "scanner.h"
+#include "keywords.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VECLEN 32
+typedef __m256i vec;
+#define VLOAD(p)     _mm256_loadu_si256((const __m256i *) (p))
+#define VSPLAT(c)    _mm256_set1_epi8(c)
+#define VEQ(a, b)    _mm256_cmpeq_epi8(a, b)
+#define VGT(a, b)    _mm256_cmpgt_epi8(a, b)
+#define VOR(a, b)    _mm256_or_si256(a, b)
+#define VAND(a, b)   _mm256_and_si256(a, b)
+#define VMASK(v)     ((unsigned) _mm256_movemask_epi8(v))
+#define VALLMASK     0xffffffffu
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define VECLEN 16
+typedef __m128i vec;
+#define VLOAD(p)     _mm_loadu_si128((const __m128i *) (p))
+#define VSPLAT(c)    _mm_set1_epi8(c)
+#define VEQ(a, b)    _mm_cmpeq_epi8(a, b)
+#define VGT(a, b)    _mm_cmpgt_epi8(a, b)
+#define VOR(a, b)    _mm_or_si128(a, b)
+#define VAND(a, b)   _mm_and_si128(a, b)
+#define VMASK(v)     ((unsigned) _mm_movemask_epi8(v))
+#define VALLMASK     0xffffu
+#endif
+
+/*
+ * lo_bits(n) -- a mask of the n low-order bits of a movemask result,
+ * i.e., of the bytes before position n in a vector.
+ */
+#define lo_bits(n)   ((1u << (n)) - 1)
+
+struct yy_buffer_state;
+
+/*
+ * All of the scanner's state is thread-local, so threads can scan
+ * different files at the same time.
+ */
+THREAD_LOCAL char *yytext;
+THREAD_LOCAL int yyleng;
+THREAD_LOCAL char *id_name;
+THREAD_LOCAL char *strval;
+THREAD_LOCAL int ival;
+THREAD_LOCAL int linenum = 1;
+THREAD_LOCAL bool scan_in_place = false;
+
+const bool scanner_thread_safe = true;
+
+static THREAD_LOCAL char *buf;     /* the buffer, if we allocated it */
+static THREAD_LOCAL char *bufp;    /* the next character to scan */
+static THREAD_LOCAL char *buflim;  /* end of the input: the first of two NULs */
+static THREAD_LOCAL char *holdp;   /* where the NUL terminating yytext was put */
+static THREAD_LOCAL char holdc;    /* the character it replaced */
+
+static int id_or_keywd(char *s);
+static char *string_lexeme(void);
+
+/*********************************************************************
+ *                                                                   *
+ *                         INPUT BUFFERS                             *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * yy_scan_buffer(base, size) -- scan the buffer base in place.  As with
+ * flex, the last two of its size bytes must be NULs.
+ */
+struct yy_buffer_state *yy_scan_buffer(char *base, size_t size)
+{
+  assert(size >= 2 && base[size-2] == '\0' && base[size-1] == '\0');
+
+  bufp = base;
+  buflim = base + size - 2;
+  holdp = NULL;
+
+  return (struct yy_buffer_state *) base;
+}
+
+/*
+ * yyrestart(fp) -- read all of fp into a buffer and start scanning it.
+ */
+void yyrestart(FILE *fp)
+{
+  size_t len = 0, size = 64*1024, n;
+
+  free(buf);
+  buf = zalloc(size);
+  while ((n = fread(buf + len, 1, size - len - 2, fp)) > 0) {
+    len += n;
+    if (size - len - 2 == 0) {
+      size *= 2;
+      buf = realloc(buf, size);
+      if (buf == NULL) {
+	fprintf(stderr, "Not enough memory\n");
+	abort();
+      }
+    }
+  }
+  buf[len] = buf[len+1] = '\0';
+
+  yy_scan_buffer(buf, len + 2);
+}
+
+/*
+ * yylex_destroy() -- free the buffer and reset the scanner, so that the
+ * next call to yylex() starts on new input.
+ */
+int yylex_destroy(void)
+{
+  free(buf);
+  buf = bufp = buflim = holdp = NULL;
+  yytext = NULL;
+  yyleng = 0;
+  linenum = 1;
+  scan_in_place = false;
+
+  return 0;
+}
+
+/*
+ * ScanText() -- return the text of the token just scanned.
+ */
+char *ScanText(void)
+{
+  return yytext;
+}
+
+/*
+ * SetText(start, end) -- make the characters from start up to end the
+ * current lexeme, and continue scanning at end.  Like flex, we put a
+ * NUL after the lexeme and put back the character it replaced on the
+ * next call to yylex().
+ */
+static void SetText(char *start, char *end)
+{
+  yytext = start;
+  yyleng = end - start;
+  bufp = end;
+
+  holdp = end;
+  holdc = *end;
+  *end = '\0';
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                           SKIPPING                                *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * SkipWhite(p) -- return a pointer to the first character at or after p
+ * that is not a blank, tab or newline, counting newlines as we go.
+ */
+static char *SkipWhite(char *p)
+{
+#ifdef VECLEN
+  vec v;
+  unsigned white, nl, stop, n;
+
+  /*
+   * Tokens are mostly separated by a single blank, or not at all, so
+   * look at the first two characters before loading a vector.
+   */
+  if (*p != ' ' && *p != '\t' && *p != '\n') {
+    return p;
+  }
+  if (p[1] != ' ' && p[1] != '\t' && p[1] != '\n') {
+    if (*p == '\n') {
+      linenum++;
+    }
+    return p + 1;
+  }
+
+  while (p + VECLEN <= buflim) {
+    v = VLOAD(p);
+    nl = VMASK(VEQ(v, VSPLAT('\n')));
+    white = VMASK(VOR(VEQ(v, VSPLAT(' ')), VEQ(v, VSPLAT('\t')))) | nl;
+    stop = ~white & VALLMASK;
+    if (stop != 0) {
+      n = __builtin_ctz(stop);
+      linenum += __builtin_popcount(nl & lo_bits(n));
+      return p + n;
+    }
+    linenum += __builtin_popcount(nl);
+    p += VECLEN;
+  }
+#endif
+
+  for ( ; *p == ' ' || *p == '\t' || *p == '\n'; p++) {
+    if (*p == '\n') {
+      linenum++;
+    }
+  }
+
+  return p;
+}
+
+/*
+ * SkipComment(p) -- p points just past the characters that open a
+ * comment; return a pointer to the character after the ones that close
+ * it, counting newlines as we go.
+ */
+static char *SkipComment(char *p)
+{
+#ifdef VECLEN
+  vec v;
+  unsigned star, nl, n;
+#endif
+
+  for (;;) {
+#ifdef VECLEN
+    while (p + VECLEN <= buflim) {
+      v = VLOAD(p);
+      star = VMASK(VEQ(v, VSPLAT('*')));
+      nl = VMASK(VEQ(v, VSPLAT('\n')));
+      if (star != 0) {
+	n = __builtin_ctz(star);
+	linenum += __builtin_popcount(nl & lo_bits(n));
+	p += n;
+	goto found_star;
+      }
+      linenum += __builtin_popcount(nl);
+      p += VECLEN;
+    }
+#endif
+    for ( ; p < buflim && *p != '*'; p++) {
+      if (*p == '\n') {
+	linenum++;
+      }
+    }
+    if (p >= buflim) {
+      fprintf(errfp, "syntax error: EOF inside comment: line %d\n", linenum);
+      CompileAbort();
+    }
+#ifdef VECLEN
+  found_star:
+#endif
+    if (p[1] == '/') {
+      return p + 2;
+    }
+    p++;
+  }
+}
+
+/*
+ * SkipIdent(p) -- return a pointer to the first character at or after p
+ * that cannot occur in an identifier, i.e., is not a letter, digit or '_'.
+ */
+static char *SkipIdent(char *p)
+{
+#ifdef VECLEN
+  vec v, lc;
+  unsigned alfa, stop;
+
+  while (p + VECLEN <= buflim) {
+    v = VLOAD(p);
+    lc = VOR(v, VSPLAT(0x20));    /* maps upper case letters to lower case */
+    alfa = VMASK(VOR(VOR(VAND(VGT(lc, VSPLAT('a'-1)), VGT(VSPLAT('z'+1), lc)),
+			 VAND(VGT(v, VSPLAT('0'-1)), VGT(VSPLAT('9'+1), v))),
+		     VEQ(v, VSPLAT('_'))));
+    stop = ~alfa & VALLMASK;
+    if (stop != 0) {
+      return p + __builtin_ctz(stop);
+    }
+    p += VECLEN;
+  }
+#endif
+
+  while (isalnum((unsigned char) *p) || *p == '_') {
+    p++;
+  }
+
+  return p;
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                            SCANNER                                *
+ *                                                                   *
+ *********************************************************************/
+
+int yylex(void)
+{
+  char *p, *q;
+
+  if (bufp == NULL) {
+    yyrestart(stdin);
+  }
+  if (holdp != NULL) {
+    *holdp = holdc;
+    holdp = NULL;
+  }
+
+  p = bufp;
+  for (;;) {
+    p = SkipWhite(p);
+    if (p[0] == '/' && p[1] == '*') {
+      p = SkipComment(p + 2);
+    }
+    else {
+      break;
+    }
+  }
+
+  if (p >= buflim) {
+    bufp = yytext = p;
+    yyleng = 0;
+    return 0;
+  }
+
+  if (isalpha((unsigned char) *p)) {
+    SetText(p, SkipIdent(p + 1));
+    return id_or_keywd(yytext);
+  }
+
+  if (isdigit((unsigned char) *p)) {
+    for (q = p + 1; isdigit((unsigned char) *q); q++) {
+    }
+    SetText(p, q);
+    ival = atoi(yytext);
+    return INTCON;
+  }
+
+  switch (*p) {
+  case '\'':
+    if (p[1] == '\\' && p[2] == 'n' && p[3] == '\'') {
+      SetText(p, p + 4);
+      ival = '\n';
+      return CHARCON;
+    }
+    if (p[1] == '\\' && p[2] == '0' && p[3] == '\'') {
+      SetText(p, p + 4);
+      ival = '\0';
+      return CHARCON;
+    }
+    if (p[1] != '\n' && p[1] != '\0' && p[2] == '\'') {
+      SetText(p, p + 3);
+      ival = yytext[1];
+      return CHARCON;
+    }
+    break;
+
+  case '"':
+    for (q = p + 1; q < buflim && *q != '"' && *q != '\n'; q++) {
+    }
+    if (q < buflim && *q == '"') {
+      SetText(p, q + 1);
+      strval = string_lexeme();
+      return STRINGCON;
+    }
+    break;
+
+  case '&':
+    if (p[1] == '&') {
+      SetText(p, p + 2);
+      return AND;
+    }
+    break;
+
+  case '|':
+    if (p[1] == '|') {
+      SetText(p, p + 2);
+      return OR;
+    }
+    break;
+
+  case '=':
+    if (p[1] == '=') {
+      SetText(p, p + 2);
+      return EQ;
+    }
+    break;
+
+  case '!':
+    if (p[1] == '=') {
+      SetText(p, p + 2);
+      return NEQ;
+    }
+    break;
+
+  case '<':
+    if (p[1] == '=') {
+      SetText(p, p + 2);
+      return LE;
+    }
+    break;
+
+  case '>':
+    if (p[1] == '=') {
+      SetText(p, p + 2);
+      return GE;
+    }
+    break;
+  }
+
+  /*
+   * Everything else, including the single-character operators and
+   * punctuation, is returned as itself.
+   */
+  SetText(p, p + 1);
+  return yytext[0];
+}
+
+/*
+ * id_or_keywd() and string_lexeme() are the same as in scanner.l; the
+ * keywords themselves are in keywords.c.
+ */
+static int id_or_keywd(char *s)
+{
+  int tok = Keyword(s, yyleng);
+
+  if (tok == ID) {
+    id_name = Intern(yytext, yyleng);
+  }
+
+  return tok;
+}
+
+static char *string_lexeme(void)
+{
+  yytext[yyleng-1] = '\0';
+
+  if (scan_in_place) {
+    return yytext+1;
+  }
+
+  return strdup(yytext+1);
+}
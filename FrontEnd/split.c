@@ -0,0 +1,517 @@
+/*
+ * split.c -- parsing the function bodies of one file on several threads.
+ *
+ * ParseSplit() goes about this in three steps:
+ *
+ *   1. PreScan() finds the top-level braces of the file, i.e., the
+ *      function bodies, skipping comments and string and character
+ *      constants the way the scanner does.
+ *
+ *   2. A first pass parses a copy of the file in which the inside of
+ *      each body has been blanked out, keeping the newlines so that line
+ *      numbers stay right.  This enters the globals, prototypes and
+ *      functions into the Global table in order, and each global notes
+ *      how many function definitions came before it.
+ *
+ *   3. Worker threads parse the function definitions, each from the end
+ *      of whatever came before it to its closing brace, with the Global
+ *      table and the atoms of the first pass shared read-only (see
+ *      SymTabImportGlobal() and AtomTabImport()).  A body only sees the
+ *      globals declared before it, as in a serial parse.  The output for
+ *      each function is captured, and written out in order at the end.
+ *
+ * If anything is amiss -- the pre-scan finds something it is not sure
+ * about, or an error is reported anywhere -- the results are thrown away
+ * and ParseSplit() returns false; the caller then parses the file
+ * serially, so that error messages are exactly those of a serial parse.
+ * This needs the thread-safe scanner (see scanner.h).
+ *
+ * With -fcache, step 3 first looks for the output of each definition in
+ * the cache (see cache.c), and only parses the ones it does not find;
+ * this is done even on a single thread.
+ */
+
+#include <pthread.h>
+#include "global.h"
+#include "error.h"
+#include "symbol-table.h"
+#include "syntax-tree.h"
+#include "scanner.h"
+#include "backend.h"
+#include "cache.h"
+#include "astwrite.h"
+#include "output.h"
+#include "split.h"
+#include "y.tab.h"
+
+extern int yyparse();
+extern void CleanupFnInfo(void);
+extern void walk_syntax_tree(symtabnode *fn_name, tnode *fn_body);
+extern THREAD_LOCAL int errstate;
+
+int parse_threads = 0;      /* set from the command line, for all compilations */
+
+/*
+ * A function definition found by PreScan().
+ */
+typedef struct {
+  char *start;              /* just after the previous top-level ';' or '}' */
+  char *body;               /* its '{' */
+  char *end;                /* just after its '}' */
+  int line;                 /* the line number at start */
+  symtabnode *fn;           /* the function, as found by the first pass */
+  char *text;               /* its output */
+  size_t textlen;
+  char *diag;               /* its diagnostics */
+  size_t diaglen;
+  int counts[NNODECOUNTS];  /* its node counts */
+  struct astblob *ast;      /* its tree, for -fdump-ast */
+} fndef;
+
+struct split {
+  fndef *defs;
+  int ndefs;
+  int next;                 /* the next definition for a worker */
+  bool failed;
+  struct globaltab *globals;
+  struct atomtab *atoms;
+  long counters[NCOUNTERS]; /* the workers' StatCounters, added up */
+  pthread_mutex_t lock;
+};
+
+static THREAD_LOCAL struct split *Split;
+static THREAD_LOCAL fndef *CurrDef;   /* the definition being parsed */
+static THREAD_LOCAL int nSeen;        /* no. of definitions the parser completed */
+
+/*
+ * PreScan(buf, len, ndefs) -- find the function definitions in the len
+ * bytes at buf.  Returns an array of them, and their number in *ndefs,
+ * or NULL if the braces don't match up or the file has anything the
+ * scanner would not take as a comment, string or character constant
+ * where one starts.
+ */
+static fndef *PreScan(char *buf, size_t len, int *ndefs)
+{
+  char *p = buf, *lim = buf + len, *start = buf;
+  int depth = 0, line = 1, startline = 1, n = 0, max = 0;
+  fndef *defs = NULL;
+
+  while (p < lim) {
+    switch (*p) {
+    case '\n':
+      line++;
+      p++;
+      break;
+
+    case '/':
+      if (p+1 < lim && p[1] == '*') {
+	for (p += 2; p+1 < lim && !(p[0] == '*' && p[1] == '/'); p++) {
+	  if (*p == '\n') line++;
+	}
+	if (p+1 >= lim) goto giveup;
+	p += 2;
+      }
+      else {
+	p++;
+      }
+      break;
+
+    case '"':
+      for (p++; p < lim && *p != '"' && *p != '\n'; p++) {
+	continue;
+      }
+      if (p >= lim || *p != '"') goto giveup;
+      p++;
+      break;
+
+    case '\'':
+      if (p+2 < lim && p[1] != '\n' && p[2] == '\'') {
+	p += 3;
+      }
+      else if (p+3 < lim && p[1] == '\\' && (p[2] == 'n' || p[2] == '0') && p[3] == '\'') {
+	p += 4;
+      }
+      else {
+	goto giveup;
+      }
+      break;
+
+    case '{':
+      if (depth++ == 0) {
+	if (n >= max) {
+	  max = (max == 0 ? 64 : 2 * max);
+	  defs = realloc(defs, max * sizeof(fndef));
+	  if (defs == NULL) {
+	    fprintf(stderr, "Not enough memory\n");
+	    abort();
+	  }
+	}
+	memset(&defs[n], 0, sizeof(fndef));
+	defs[n].start = start;
+	defs[n].body = p;
+	defs[n].line = startline;
+      }
+      p++;
+      break;
+
+    case '}':
+      if (depth == 0) goto giveup;
+      p++;
+      if (--depth == 0) {
+	defs[n++].end = p;
+	start = p;
+	startline = line;
+      }
+      break;
+
+    case ';':
+      p++;
+      if (depth == 0) {
+	start = p;
+	startline = line;
+      }
+      break;
+
+    case '\0':
+      goto giveup;
+
+    default:
+      p++;
+    }
+  }
+  if (depth != 0) goto giveup;
+
+  *ndefs = n;
+  return defs;
+
+ giveup:
+  free(defs);
+  return NULL;
+}
+
+/*
+ * SkipBody(fn, body) -- the first pass's FunctionSink: note the function
+ * of each definition.
+ */
+static void SkipBody(symtabnode *fn, tnode *body)
+{
+  if (nSeen < Split->ndefs) {
+    Split->defs[nSeen].fn = fn;
+  }
+  nSeen++;
+}
+
+/*
+ * CaptureBody(fn, body) -- the workers' FunctionSink: process the
+ * function, with output going to the buffer of the current definition,
+ * and keep its node counts and, for -fdump-ast, its tree.
+ */
+static void CaptureBody(symtabnode *fn, tnode *body)
+{
+  if (++nSeen > 1 || fn != CurrDef->fn) {
+    nSeen = 2;
+    return;
+  }
+  walk_syntax_tree(fn, body);
+  memcpy(CurrDef->counts, FnNodeCount, sizeof(FnNodeCount));
+  CurrDef->ast = AstCapture(fn, body);
+}
+
+/*
+ * LoadDef(dp, text) -- copy the definition dp into text, which has room
+ * for it and two NULs, and have the scanner start on it.  The scanner
+ * writes into the buffer, so it needs a fresh copy each time.
+ */
+static void LoadDef(fndef *dp, char *text)
+{
+  size_t n = dp->end - dp->start;
+
+  memcpy(text, dp->start, n);
+  text[n] = text[n+1] = '\0';
+  yy_scan_buffer(text, n + 2);
+  scan_in_place = true;
+  linenum = dp->line;
+}
+
+/*
+ * HashDef(key) -- compute the cache key for the definition the scanner
+ * is on (see cache.c): its tokens, and for each identifier the type of
+ * the global it refers to, if any.  Locals may hide some of these; that
+ * only makes the key depend on more than it has to.
+ */
+static void HashDef(cachekey *key)
+{
+  int tok;
+
+  CacheKeyInit(key);
+  while ((tok = yylex()) != 0) {
+    CacheKeyAdd(key, &tok, sizeof(tok));
+    switch (tok) {
+    case ID:
+      CacheKeyAdd(key, id_name, strlen(id_name) + 1);
+      CacheKeySymbol(key, SymTabLookup(id_name, Global));
+      break;
+    case INTCON:
+    case CHARCON:
+      CacheKeyAdd(key, &ival, sizeof(ival));
+      break;
+    case STRINGCON:
+      CacheKeyAdd(key, strval, strlen(strval) + 1);
+      break;
+    }
+  }
+}
+
+/*
+ * ParseDef(k) -- parse the k'th definition, on a worker thread, unless
+ * its output is in the cache.  Returns true if it parsed without errors
+ * into the function found by the first pass.
+ */
+static bool ParseDef(int k)
+{
+  fndef *dp = &Split->defs[k];
+  char *volatile text;
+  char *cached = NULL;
+  size_t cachedlen = 0;
+  FILE *err;
+  volatile int r = 0;
+  volatile bool hit = false;
+  cachekey key;
+  jmp_buf env;
+  bool ok;
+
+  text = malloc(dp->end - dp->start + 2);
+  err = open_memstream(&dp->diag, &dp->diaglen);
+  if (text == NULL || err == NULL) {
+    fprintf(stderr, "Not enough memory\n");
+    abort();
+  }
+
+  OutCapture();
+  errfp = err;
+  SymTabImportGlobal(Split->globals, k);
+  errstate = ORDINARY;
+  errcount = 0;
+  CurrDef = dp;
+  nSeen = 0;
+
+  abort_env = &env;
+  if (setjmp(env) == 0) {
+    if (cache_dir != NULL) {
+      LoadDef(dp, text);
+      HashDef(&key);
+      hit = (errcount == 0 && CacheLookup(&key, &cached, &cachedlen, dp->counts));
+    }
+    if (!hit) {
+      LoadDef(dp, text);
+      r = yyparse();
+    }
+  }
+  else {
+    r = -1;
+  }
+  abort_env = NULL;
+  CleanupFnInfo();
+
+  dp->text = OutCaptured(&dp->textlen);
+  fclose(err);
+  errfp = NULL;
+  free(text);
+
+  if (hit) {
+    free(dp->text);
+    dp->text = cached;
+    dp->textlen = cachedlen;
+    return true;
+  }
+  ok = (r == 0 && errcount == 0 && nSeen == 1);
+  if (ok && cache_dir != NULL && dp->diaglen == 0) {
+    CacheStore(&key, dp->text, dp->textlen, dp->counts);
+  }
+  return ok;
+}
+
+/*
+ * SplitWorker(arg) -- parse definitions for the split arg until there
+ * are none left or one of them failed.  The thread's own tables and
+ * regions are only used for the local symbols and syntax trees, and
+ * freed at the end.
+ */
+static void *SplitWorker(void *arg)
+{
+  int i, k;
+  bool ok = true;
+
+  Split = arg;
+  StatsStart();
+  AtomTabImport(Split->atoms);
+  SymTabImportGlobal(Split->globals, 0);
+  SymTabInit(Local);
+  FunctionSink = CaptureBody;
+
+  for (;;) {
+    pthread_mutex_lock(&Split->lock);
+    if (!ok) {
+      Split->failed = true;
+    }
+    k = (Split->failed ? Split->ndefs : Split->next++);
+    pthread_mutex_unlock(&Split->lock);
+    if (k >= Split->ndefs) {
+      break;
+    }
+    ok = ParseDef(k);
+  }
+
+  FunctionSink = NULL;
+  yylex_destroy();
+  SymTabImportGlobal(NULL, 0);
+  AtomTabImport(NULL);
+  SymTabFree();
+  SynTreeFree();
+  AtomTabFree();
+  RegionFree(RGN_FUNCTION);
+  RegionFree(RGN_PROGRAM);
+
+  pthread_mutex_lock(&Split->lock);
+  for (i = 0; i < NCOUNTERS; i++) {
+    Split->counters[i] += StatCounters[i];
+  }
+  pthread_mutex_unlock(&Split->lock);
+
+  return NULL;
+}
+
+/*
+ * FirstPass(sp, buf, len) -- parse the len bytes at buf with the function
+ * bodies blanked out, into the Global table of the calling thread.
+ * Diagnostics go to the buffer *diag.  Returns true if there were no
+ * errors and the parser saw the same definitions as PreScan().
+ */
+static bool FirstPass(struct split *sp, char *buf, size_t len,
+		      char **diag, size_t *diaglen)
+{
+  char *volatile skel, *p;
+  FILE *err, *saved_errfp = errfp;
+  jmp_buf env, *saved_env = abort_env;
+  volatile int r;
+  int k;
+
+  skel = malloc(len + 2);
+  err = open_memstream(diag, diaglen);
+  if (skel == NULL || err == NULL) {
+    fprintf(stderr, "Not enough memory\n");
+    abort();
+  }
+  memcpy(skel, buf, len);
+  skel[len] = skel[len+1] = '\0';
+  for (k = 0; k < sp->ndefs; k++) {
+    for (p = skel + (sp->defs[k].body - buf) + 1; p < skel + (sp->defs[k].end - buf) - 1; p++) {
+      if (*p != '\n') *p = ' ';
+    }
+  }
+
+  errfp = err;
+  yy_scan_buffer(skel, len + 2);
+  scan_in_place = true;
+  FunctionSink = SkipBody;
+  nSeen = 0;
+
+  abort_env = &env;
+  if (setjmp(env) == 0) {
+    r = yyparse();
+  }
+  else {
+    r = -1;
+  }
+  abort_env = saved_env;
+
+  FunctionSink = NULL;
+  fclose(err);
+  errfp = saved_errfp;
+  free(skel);
+
+  return r == 0 && errcount == 0 && nSeen == sp->ndefs;
+}
+
+/*
+ * ParseSplit(buf, len) -- parse the len bytes at buf, which are followed
+ * by two NULs, on parse_threads threads (at least one) as described
+ * above, and write out the output for its functions.  Returns false if
+ * this could not be done; the caller must then throw away the state of
+ * the compilation and parse the file serially.
+ */
+bool ParseSplit(char *buf, size_t len)
+{
+  struct split sp;
+  pthread_t *tids;
+  char *diag = NULL;
+  size_t diaglen = 0;
+  bool ok;
+  int i, nthreads = (parse_threads > 0 ? parse_threads : 1);
+
+  if (!scanner_thread_safe || (parse_threads <= 0 && cache_dir == NULL)) {
+    return false;
+  }
+
+  memset(&sp, 0, sizeof(sp));
+  if ((sp.defs = PreScan(buf, len, &sp.ndefs)) == NULL) {
+    return false;
+  }
+  if (sp.ndefs < (cache_dir != NULL ? 1 : 2)) {
+    free(sp.defs);
+    return false;
+  }
+
+  Split = &sp;
+  ok = FirstPass(&sp, buf, len, &diag, &diaglen);
+
+  if (ok) {
+    sp.globals = SymTabExportGlobal();
+    sp.atoms = AtomTabExport();
+    pthread_mutex_init(&sp.lock, NULL);
+
+    tids = zalloc(nthreads * sizeof(pthread_t));
+    for (i = 0; i < nthreads; i++) {
+      if (pthread_create(&tids[i], NULL, SplitWorker, &sp) != 0) {
+	fprintf(stderr, "compile: can't create parser thread\n");
+	abort();
+      }
+    }
+    for (i = 0; i < nthreads; i++) {
+      pthread_join(tids[i], NULL);
+    }
+    free(tids);
+    pthread_mutex_destroy(&sp.lock);
+    free(sp.globals);
+    free(sp.atoms);
+
+    ok = !sp.failed;
+    for (i = 0; i < NCOUNTERS; i++) {
+      StatCounters[i] += sp.counters[i];
+    }
+    if (cache_dir != NULL && sp.counters[CNT_CACHE_MISSES] > 0) {
+      CacheTrim();
+    }
+  }
+
+  if (ok) {
+    fwrite(diag, 1, diaglen, errfp);
+  }
+  for (i = 0; i < sp.ndefs; i++) {
+    if (ok) {
+      fwrite(sp.defs[i].diag, 1, sp.defs[i].diaglen, errfp);
+      BackendEmit(sp.defs[i].fn, sp.defs[i].text, sp.defs[i].textlen,
+		  sp.defs[i].counts, sp.defs[i].ast);
+    }
+    else {
+      AstFree(sp.defs[i].ast);
+    }
+    free(sp.defs[i].text);
+    free(sp.defs[i].diag);
+  }
+  free(diag);
+  free(sp.defs);
+  Split = NULL;
+
+  return ok;
+}
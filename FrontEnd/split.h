@@ -0,0 +1,12 @@
+/*
+ * split.h -- parsing the function bodies of one file on several threads.
+ */
+
+#ifndef _SPLIT_H_
+#define _SPLIT_H_
+
+extern int parse_threads;   /* 0: parse files serially */
+
+bool ParseSplit(char *buf, size_t len);
+
+#endif  /* _SPLIT_H_ */
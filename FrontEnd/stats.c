@@ -0,0 +1,160 @@
+/*
+ * stats.c -- per-phase timing and event counts for the front end,
+ * printed at exit when compile is run with -ftime-report.
+ */
+
+#include <time.h>
+#include <sys/resource.h>
+#include "global.h"
+
+THREAD_LOCAL long StatCounters[NCOUNTERS];
+int time_report = 0;        /* set from the command line, for all threads */
+
+static char *PhaseName[NPHASES] = {
+  "other", "lex", "parse", "semantic", "symtab", "process"
+};
+
+static char *CounterName[NCOUNTERS] = {
+  "lines", "tokens", "reductions", "nodes", "folded", "shared", "lookups",
+  "inserts", "zalloc_bytes", "ralloc_bytes", "functions", "cache_hits",
+  "cache_misses", "cache_evicts"
+};
+
+#define MAXPHASEDEPTH 16
+
+static THREAD_LOCAL long long PhaseTime[NPHASES];   /* nanoseconds */
+static THREAD_LOCAL long PhaseCalls[NPHASES];
+static THREAD_LOCAL Phase PhaseStack[MAXPHASEDEPTH];
+static THREAD_LOCAL int phaseDepth = 0;
+static THREAD_LOCAL long long lastTime, startTime;
+
+static long long Now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/*
+ * TimerPush(p) -- charge the time since the last phase change to the
+ * current phase, and make p the current phase.
+ */
+void TimerPush(Phase p)
+{
+  long long t = Now();
+
+  assert(phaseDepth < MAXPHASEDEPTH - 1);
+  PhaseTime[PhaseStack[phaseDepth]] += t - lastTime;
+  PhaseStack[++phaseDepth] = p;
+  PhaseCalls[p]++;
+  lastTime = t;
+}
+
+/*
+ * TimerPop() -- charge the time since the last phase change to the
+ * current phase, and go back to the phase that was current before it.
+ */
+void TimerPop(void)
+{
+  long long t = Now();
+
+  assert(phaseDepth > 0);
+  PhaseTime[PhaseStack[phaseDepth--]] += t - lastTime;
+  lastTime = t;
+}
+
+/*
+ * StatsStart() -- clear the counters and timers at the start of a
+ * compilation, and start the clock if a time report was asked for.
+ */
+void StatsStart(void)
+{
+  memset(StatCounters, 0, sizeof(StatCounters));
+  memset(PhaseTime, 0, sizeof(PhaseTime));
+  memset(PhaseCalls, 0, sizeof(PhaseCalls));
+  PhaseStack[0] = PH_OTHER;
+  phaseDepth = 0;
+  if (time_report) {
+    startTime = lastTime = Now();
+  }
+}
+
+/*
+ * TimedLex() -- the parser calls this in place of yylex() (see parser.y),
+ * to count tokens and time the scanner.
+ */
+int TimedLex(void)
+{
+  extern int yylex(void);
+  int tok;
+
+  CountEvent(CNT_TOKENS, 1);
+  if (!time_report) return yylex();
+
+  TimerPush(PH_LEX);
+  tok = yylex();
+  TimerPop();
+
+  return tok;
+}
+
+/*
+ * PeakRSS() -- the most memory the process has had resident so far, in
+ * kilobytes (for all threads, so with -j it is not that of one file).
+ */
+static long PeakRSS(void)
+{
+  struct rusage ru;
+
+  if (getrusage(RUSAGE_SELF, &ru) < 0) return 0;
+  return ru.ru_maxrss;
+}
+
+/*
+ * PrintTimeReport() -- print the time spent in each phase, the event
+ * counts and the peak RSS to stderr, as a table or as a JSON object.
+ */
+void PrintTimeReport(void)
+{
+  long long t, total;
+  int i;
+
+  if (!time_report) return;
+
+  while (phaseDepth > 0) TimerPop();
+  t = Now();
+  PhaseTime[PH_OTHER] += t - lastTime;
+  total = t - startTime;
+  if (total <= 0) total = 1;
+
+  if (time_report == 2) {
+    fprintf(errfp, "{\n  \"total_ms\": %.3f,\n  \"peak_rss_kb\": %ld,\n"
+	    "  \"phases\": {\n", total / 1e6, PeakRSS());
+    for (i = 0; i < NPHASES; i++) {
+      fprintf(errfp, "    \"%s\": {\"ms\": %.3f, \"calls\": %ld}%s\n",
+	      PhaseName[i], PhaseTime[i] / 1e6, PhaseCalls[i],
+	      i < NPHASES-1 ? "," : "");
+    }
+    fprintf(errfp, "  },\n  \"counters\": {\n");
+    for (i = 0; i < NCOUNTERS; i++) {
+      fprintf(errfp, "    \"%s\": %ld%s\n",
+	      CounterName[i], StatCounters[i], i < NCOUNTERS-1 ? "," : "");
+    }
+    fprintf(errfp, "  }\n}\n");
+    return;
+  }
+
+  fprintf(errfp, "Execution times (ms)\n");
+  for (i = 0; i < NPHASES; i++) {
+    fprintf(errfp, "  %-12s %10.3f  %5.1f%%  %10ld calls\n",
+	    PhaseName[i], PhaseTime[i] / 1e6, 100.0 * PhaseTime[i] / total,
+	    PhaseCalls[i]);
+  }
+  fprintf(errfp, "  %-12s %10.3f\n", "TOTAL", total / 1e6);
+  fprintf(errfp, "Counts\n");
+  for (i = 0; i < NCOUNTERS; i++) {
+    fprintf(errfp, "  %-12s %10ld\n", CounterName[i], StatCounters[i]);
+  }
+  fprintf(errfp, "Peak RSS %10ld KB\n", PeakRSS());
+}
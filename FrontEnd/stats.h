@@ -0,0 +1,58 @@
+/*
+ * stats.h -- compile-time statistics: time spent in each phase of the
+ * front end, and counts of the work done.
+ */
+
+#ifndef _STATS_H_
+#define _STATS_H_
+
+/*
+ * Phases.  Time is charged to the innermost phase being executed, so
+ * e.g. the time for PH_PARSE does not include the time spent in yylex()
+ * or in the symbol table routines called from semantic actions.
+ */
+typedef enum {
+  PH_OTHER,       /* everything not covered by another phase */
+  PH_LEX,         /* yylex() */
+  PH_PARSE,       /* yyparse() itself: shifts, reductions and actions */
+  PH_SEMANTIC,    /* type checking in SynTreeUnExp(), SynTreeBinExp() etc. */
+  PH_SYMTAB,      /* symbol table lookups, insertions and cleanup */
+  PH_PROCESS,     /* process_syntax_tree() */
+  NPHASES
+} Phase;
+
+typedef enum {
+  CNT_LINES,
+  CNT_TOKENS,
+  CNT_REDUCTIONS,
+  CNT_NODES,      /* syntax tree nodes built */
+  CNT_FOLDED,     /* operators folded into constants */
+  CNT_SHARED,     /* nodes reused by -fshare-exprs instead of built */
+  CNT_LOOKUPS,    /* symbol table lookups */
+  CNT_INSERTS,    /* symbol table insertions */
+  CNT_ZALLOC,     /* bytes allocated by zalloc() */
+  CNT_RALLOC,     /* bytes allocated by ralloc() */
+  CNT_FUNCS,      /* function bodies processed */
+  CNT_CACHE_HITS,     /* functions found in the cache (see cache.c) */
+  CNT_CACHE_MISSES,
+  CNT_CACHE_EVICTS,   /* cache entries removed to keep it under its size */
+  NCOUNTERS
+} Counter;
+
+extern THREAD_LOCAL long StatCounters[NCOUNTERS];
+extern int time_report;   /* 0: off, 1: table, 2: JSON */
+
+/*
+ * The counters are always maintained; phase timers only run when a time
+ * report was asked for, so that they cost just a test otherwise.
+ */
+#define CountEvent(c, n)  (StatCounters[c] += (n))
+#define PhaseBegin(p)     (time_report ? TimerPush(p) : (void) 0)
+#define PhaseEnd()        (time_report ? TimerPop() : (void) 0)
+
+void TimerPush(Phase p);
+void TimerPop(void);
+void StatsStart(void);
+void PrintTimeReport(void);
+
+#endif  /* _STATS_H_ */
@@ -5,74 +5,487 @@
  */
 
 #include <assert.h>
+#include <limits.h>
 #include "global.h"
 #include "symbol-table.h"
+#include "syntax-tree.h"
+#include "output.h"
 
-extern int CurrScope, CurrType, fnRetType;
-extern char *fnName;
-extern llistptr lptr;
-extern bool is_extern;
-extern symtabnode *currFun;
+extern THREAD_LOCAL int CurrScope, CurrType, fnRetType;
+extern THREAD_LOCAL char *fnName;
+extern THREAD_LOCAL llistptr lptr;
+extern THREAD_LOCAL bool is_extern;
+extern THREAD_LOCAL symtabnode *currFun;
 
-#define HASHTBLSZ 256
+/*
+ * Each scope has an open-addressing hash table using Robin Hood
+ * insertion: an entry that is further from its home slot than the
+ * occupant of a slot takes that slot over, and the occupant moves on.
+ * This keeps probe sequences short and lets a lookup stop as soon as it
+ * reaches an entry closer to home than the key would be.  The table is
+ * doubled when it gets more than 3/4 full.
+ */
+#define SYMTBLSZ_INIT  64     /* initial no. of slots: a power of 2 */
+
+typedef struct {
+  unsigned hash;              /* hash value of the entry's name */
+  symtabnode *stptr;          /* NULL if the slot is empty */
+} stslot;
+
+static THREAD_LOCAL struct {
+  stslot *slots;
+  unsigned size;              /* no. of slots: always a power of 2 */
+  unsigned count;             /* no. of occupied slots */
+} SymTab[2];
+
+/*
+ * Block scopes within a function are handled with an undo log: every
+ * insertion into the Local table is recorded in UndoLog, along with the
+ * entry of an outer block it shadows, if any.  Entering a block pushes
+ * the current length of the log on ScopeMarks; leaving it undoes the
+ * insertions made since then.  The local symbols of a function are thus
+ * dropped in time proportional to their number.
+ */
+static THREAD_LOCAL struct undo {
+  symtabnode *stptr;          /* the entry inserted */
+  symtabnode *shadowed;       /* the entry it hid, or NULL */
+} *UndoLog;
+static THREAD_LOCAL unsigned nUndo, maxUndo;
+
+static THREAD_LOCAL unsigned *ScopeMarks;
+static THREAD_LOCAL unsigned nMarks, maxMarks;   /* nMarks is the current block level */
+
+/*
+ * nFunDefs counts the function definitions seen so far; each global
+ * records the count at its declaration.  When the Global table is
+ * borrowed from another thread (SymTabImportGlobal()), globals with a
+ * count greater than VisibleDefs are not seen by lookups.
+ */
+static THREAD_LOCAL int nFunDefs;
+static THREAD_LOCAL int nGlobals;     /* no. of globals declared so far */
+static THREAD_LOCAL int VisibleDefs = INT_MAX;
+static THREAD_LOCAL bool GlobalImported;
+
+struct globaltab {
+  stslot *slots;
+  unsigned size, count;
+};
+
+/*
+ * hash(str) -- symbol names are atoms (see Intern() in util.c), so the
+ * hash value comes with the name and names can be compared by address.
+ * The atom's hash is run through a finalizer so that all of its bits
+ * affect the low-order bits used to pick a slot.
+ */
+static unsigned hash(char *str)
+{
+  unsigned h = AtomHash(str);
+
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+
+  return h;
+}
+
+/*
+ * ProbeDist(sc, i) -- how far the entry in slot i of scope sc is from
+ * its home slot.
+ */
+#define ProbeDist(sc, i) \
+  (((i) - SymTab[sc].slots[i].hash) & (SymTab[sc].size - 1))
 
-static symtabnode *SymTab[2][HASHTBLSZ];
+/*
+ * SlotInsert(sc, h, stptr) -- put the symbol stptr with hash value h
+ * into the table for scope sc, which must have a free slot.
+ */
+static void SlotInsert(int sc, unsigned h, symtabnode *stptr)
+{
+  stslot *slots = SymTab[sc].slots, tmp;
+  unsigned mask = SymTab[sc].size - 1;
+  unsigned i, dist, d;
+
+  for (i = h & mask, dist = 0; slots[i].stptr != NULL; i = (i+1) & mask, dist++) {
+    d = ProbeDist(sc, i);
+    if (d < dist) {
+      /*
+       * The occupant is closer to home than we are: take its slot and
+       * carry on inserting it instead.
+       */
+      tmp = slots[i];
+      slots[i].hash = h;
+      slots[i].stptr = stptr;
+      h = tmp.hash;
+      stptr = tmp.stptr;
+      dist = d;
+    }
+  }
+
+  slots[i].hash = h;
+  slots[i].stptr = stptr;
+  SymTab[sc].count++;
+}
+
+/*
+ * GrowSymTab(sc) -- double the number of slots in the table for scope
+ * sc, and reinsert all its entries.
+ */
+static void GrowSymTab(int sc)
+{
+  stslot *oldslots = SymTab[sc].slots;
+  unsigned i, oldsize = SymTab[sc].size;
 
-static int hash(char *str)
+  SymTab[sc].size = (oldsize == 0 ? SYMTBLSZ_INIT : 2 * oldsize);
+  SymTab[sc].slots = zalloc(SymTab[sc].size * sizeof(stslot));
+  SymTab[sc].count = 0;
+
+  for (i = 0; i < oldsize; i++) {
+    if (oldslots[i].stptr != NULL) {
+      SlotInsert(sc, oldslots[i].hash, oldslots[i].stptr);
+    }
+  }
+
+  free(oldslots);
+}
+
+/*
+ * FindSlot(sc, stptr) -- return the index of the slot holding the entry
+ * stptr in the table for scope sc, which must contain it.
+ */
+static unsigned FindSlot(int sc, symtabnode *stptr)
 {
-  int n = 0;
+  unsigned mask = SymTab[sc].size - 1;
+  unsigned i;
 
-  for ( ; str != NULL && *str != '\0'; str++) {
-    n += *str;
+  for (i = hash(stptr->name) & mask;
+       SymTab[sc].slots[i].stptr != stptr;
+       i = (i+1) & mask) {
+    assert(SymTab[sc].slots[i].stptr != NULL);
   }
 
-  return n % HASHTBLSZ;
+  return i;
+}
+
+/*
+ * SlotDelete(sc, i) -- remove the entry in slot i of the table for scope
+ * sc.  The entries after it in the same run are shifted back one slot,
+ * up to one that is already in its home slot, so that no lookup has to
+ * step over a hole.
+ */
+static void SlotDelete(int sc, unsigned i)
+{
+  stslot *slots = SymTab[sc].slots;
+  unsigned mask = SymTab[sc].size - 1;
+  unsigned j;
+
+  for (j = (i+1) & mask;
+       slots[j].stptr != NULL && ProbeDist(sc, j) > 0;
+       i = j, j = (j+1) & mask) {
+    slots[i] = slots[j];
+  }
+
+  slots[i].stptr = NULL;
+  SymTab[sc].count--;
+}
+
+/*
+ * Undo(n) -- undo the insertions into the Local table recorded in the
+ * undo log past its first n entries.
+ */
+static void Undo(unsigned n)
+{
+  struct undo *u;
+  unsigned i;
+
+  while (nUndo > n) {
+    u = &UndoLog[--nUndo];
+    i = FindSlot(Local, u->stptr);
+    if (u->shadowed != NULL) {
+      SymTab[Local].slots[i].stptr = u->shadowed;
+    }
+    else {
+      SlotDelete(Local, i);
+    }
+  }
 }
 
 /*
  * SymTabInit(sc)
  *
- * Given a scope sc, initialize the symbol table for that scope by setting
- * all the hash table buckets to NULL.
+ * Given a scope sc, initialize the symbol table for that scope to empty.
+ * For the Local table this only removes the entries that are in it.
  */
 void SymTabInit(int sc)
 {
+  assert(sc == Local || !GlobalImported);
+  if (sc == Global) {
+    nFunDefs = 0;
+    nGlobals = 0;
+  }
+  if (SymTab[sc].slots == NULL) {
+    GrowSymTab(sc);
+  }
+  else if (sc == Local) {
+    Undo(0);
+    nMarks = 0;
+  }
+  else {
+    memset(SymTab[sc].slots, 0, SymTab[sc].size * sizeof(stslot));
+    SymTab[sc].count = 0;
+  }
+}
+
+/*
+ * SymTabFree()
+ *
+ * Free the memory used by both symbol tables and the undo log, at the
+ * end of a compilation.  The tables have to be set up with SymTabInit()
+ * before they are used again.
+ */
+void SymTabFree(void)
+{
+  int sc;
+
+  for (sc = 0; sc < 2; sc++) {
+    free(SymTab[sc].slots);
+    SymTab[sc].slots = NULL;
+    SymTab[sc].size = SymTab[sc].count = 0;
+  }
+  free(UndoLog);
+  free(ScopeMarks);
+  UndoLog = NULL;
+  ScopeMarks = NULL;
+  nUndo = maxUndo = nMarks = maxMarks = 0;
+}
+
+/*
+ * SymTabExportGlobal()
+ *
+ * Return a description of the Global table of the calling thread, for
+ * SymTabImportGlobal() on other threads.  The table must not change
+ * while they use it.
+ */
+struct globaltab *SymTabExportGlobal(void)
+{
+  struct globaltab *gt = zalloc(sizeof(struct globaltab));
+
+  gt->slots = SymTab[Global].slots;
+  gt->size = SymTab[Global].size;
+  gt->count = SymTab[Global].count;
+
+  return gt;
+}
+
+/*
+ * SymTabImportGlobal(gt, ndefs)
+ *
+ * Make the Global table gt of another thread the Global table of the
+ * calling thread, read-only, with only the globals declared before the
+ * function definition numbered ndefs (from 0) visible.  If gt is NULL,
+ * go back to an empty Global table of the thread's own.
+ */
+void SymTabImportGlobal(struct globaltab *gt, int ndefs)
+{
+  if (gt == NULL) {
+    SymTab[Global].slots = NULL;
+    SymTab[Global].size = SymTab[Global].count = 0;
+    VisibleDefs = INT_MAX;
+    GlobalImported = false;
+    return;
+  }
+
+  if (!GlobalImported) {
+    free(SymTab[Global].slots);
+  }
+  SymTab[Global].slots = gt->slots;
+  SymTab[Global].size = gt->size;
+  SymTab[Global].count = gt->count;
+  VisibleDefs = ndefs;
+  GlobalImported = true;
+}
+
+/*
+ * SymTabSeedGlobal(gt)
+ *
+ * Fill the Global table of the calling thread, which must be empty,
+ * with copies of the entries of the Global table gt of another thread
+ * (see LoadPrelude() in compile.c).  The slots are copied as they are,
+ * so this takes no hashing; the entries are copied into RGN_PROGRAM, so
+ * that a definition of a function declared in gt only changes the copy.
+ */
+void SymTabSeedGlobal(struct globaltab *gt)
+{
+  stslot *slots;
+  symtabnode *stptr;
+  unsigned i;
+
+  assert(!GlobalImported && SymTab[Global].count == 0);
+  if (gt->count == 0) {
+    return;
+  }
+
+  if (SymTab[Global].size != gt->size) {
+    free(SymTab[Global].slots);
+    SymTab[Global].slots = zalloc(gt->size * sizeof(stslot));
+    SymTab[Global].size = gt->size;
+  }
+  slots = SymTab[Global].slots;
+  memcpy(slots, gt->slots, gt->size * sizeof(stslot));
+  SymTab[Global].count = gt->count;
+  nGlobals = gt->count;
+
+  for (i = 0; i < gt->size; i++) {
+    if (slots[i].stptr != NULL) {
+      stptr = ralloc(RGN_PROGRAM, sizeof(symtabnode));
+      *stptr = *slots[i].stptr;
+      stptr->ndefs = 0;
+      slots[i].stptr = stptr;
+    }
+  }
+}
+
+/*
+ * SymTabMakeGlobal(syms, n)
+ *
+ * Make a Global table, apart from that of any thread, holding the n
+ * entries in syms, whose names must be atoms, for SymTabSeedGlobal() by
+ * any number of threads (see pch.c).  The entries are numbered in the
+ * order given.  The table is built in the Global table of the calling
+ * thread, which is put back as it was afterwards.
+ */
+struct globaltab *SymTabMakeGlobal(symtabnode **syms, int n)
+{
+  struct globaltab *gt = zalloc(sizeof(struct globaltab));
+  stslot *slots = SymTab[Global].slots;
+  unsigned size = SymTab[Global].size, count = SymTab[Global].count;
   int i;
 
-  for (i = 0; i < HASHTBLSZ; i++) {
-    SymTab[sc][i] = NULL;
+  SymTab[Global].slots = NULL;
+  SymTab[Global].size = SymTab[Global].count = 0;
+  GrowSymTab(Global);
+  for (i = 0; i < n; i++) {
+    if (4 * (SymTab[Global].count + 1) > 3 * SymTab[Global].size) {
+      GrowSymTab(Global);
+    }
+    syms[i]->index = i;
+    SlotInsert(Global, hash(syms[i]->name), syms[i]);
+  }
+
+  gt->slots = SymTab[Global].slots;
+  gt->size = SymTab[Global].size;
+  gt->count = SymTab[Global].count;
+  SymTab[Global].slots = slots;
+  SymTab[Global].size = size;
+  SymTab[Global].count = count;
+
+  return gt;
+}
+
+/*
+ * SymTabGlobals(n)
+ *
+ * Return an array, from malloc, of the entries of the Global table in
+ * the order they were declared, and their number in *n.
+ */
+symtabnode **SymTabGlobals(int *n)
+{
+  symtabnode **globals, *stptr;
+  unsigned i;
+
+  globals = zalloc((nGlobals > 0 ? nGlobals : 1) * sizeof(symtabnode *));
+  for (i = 0; i < SymTab[Global].size; i++) {
+    if ((stptr = SymTab[Global].slots[i].stptr) != NULL) {
+      assert(stptr->index < nGlobals);
+      globals[stptr->index] = stptr;
+    }
+  }
+
+  *n = nGlobals;
+  return globals;
+}
+
+/*
+ * SymTabEnterScope()
+ *
+ * Start a new block scope in the Local table: locals declared from now
+ * on hide any locals of the same name in enclosing blocks.  Returns the
+ * block level before the new scope, to be passed to SymTabExitScope().
+ */
+int SymTabEnterScope(void)
+{
+  if (nMarks >= maxMarks) {
+    maxMarks = (maxMarks == 0 ? 16 : 2 * maxMarks);
+    ScopeMarks = realloc(ScopeMarks, maxMarks * sizeof(*ScopeMarks));
+    if (ScopeMarks == NULL) {
+      fprintf(stderr, "Not enough memory\n");
+      abort();
+    }
+  }
+
+  ScopeMarks[nMarks++] = nUndo;
+  return nMarks - 1;
+}
+
+/*
+ * SymTabExitScope(level)
+ *
+ * End the block scope that SymTabEnterScope() returned level for, and
+ * any scopes inside it that are still open because error recovery threw
+ * away their closing braces: remove the locals declared in them from the
+ * Local table, making visible again any that they hid.  The entries
+ * themselves stay around until the end of the function, since the
+ * syntax tree may point to them.
+ */
+void SymTabExitScope(int level)
+{
+  if (level >= 0 && (unsigned) level < nMarks) {
+    Undo(ScopeMarks[level]);
+    nMarks = level;
   }
 }
 
 /*
  * SymTabLookup(str, sc)
  *
- * Look up the string str in the symbol table with scope sc.  If found,
+ * Look up the atom str in the symbol table with scope sc.  If found,
  * return a pointer to the corresponding symbol table node, otherwise
  * return NULL.
  */
 symtabnode *SymTabLookup(char *str, int sc)
 {
-  int hval;
-  symtabnode *stptr;
+  stslot *slots = SymTab[sc].slots;
+  unsigned mask = SymTab[sc].size - 1;
+  unsigned h, i, dist;
+  symtabnode *stptr = NULL;
 
   assert(str);
+  CountEvent(CNT_LOOKUPS, 1);
+  PhaseBegin(PH_SYMTAB);
 
-  hval = hash(str);
+  h = hash(str);
 
-  for (stptr = SymTab[sc][hval]; stptr != NULL; stptr = stptr->next) {
-    if (strcmp(str, stptr->name) == 0) {
-      return stptr;
+  for (i = h & mask, dist = 0;
+       slots[i].stptr != NULL && ProbeDist(sc, i) >= dist;
+       i = (i+1) & mask, dist++) {
+    if (slots[i].stptr->name == str) {
+      stptr = slots[i].stptr;
+      break;
     }
   }
+  if (stptr != NULL && sc == Global && stptr->ndefs > VisibleDefs) {
+    stptr = NULL;
+  }
 
-  return NULL;
+  PhaseEnd();
+  return stptr;
 }
 
 /*
  * SymTabLookupAll(str)
  *
- * Look up the string str in the symbol table, starting with the
+ * Look up the atom str in the symbol table, starting with the
  * local symbol table and then (if not found) in the global table.
  * If found in either table, return a pointer to the corresponding
  * symbol table node, otherwise return NULL.
@@ -95,31 +508,69 @@ symtabnode *SymTabLookupAll(char *str)
 /*
  * SymTabInsert(str, sc)
  *
- * Add string str to the symbol table with scope sc, and return a
+ * Add atom str to the symbol table with scope sc, and return a
  * pointer to the resulting entry.  This code assumes that str does not
- * already occur in that symbol table; it gives an error message if it does.
+ * already occur in that symbol table at the current block level; it gives
+ * an error message if it does.  A local may hide one of the same name
+ * declared in an enclosing block.
  */
 symtabnode *SymTabInsert(char *str, int sc)
 {
-  int hval;
-  symtabnode *sptr;
+  symtabnode *sptr, *shadowed = NULL;
+  int level = (sc == Global ? 0 : nMarks);
   
   assert(str != 0);
+  assert(sc == Local || !GlobalImported);
+  CountEvent(CNT_INSERTS, 1);
+  PhaseBegin(PH_SYMTAB);
 
   sptr = SymTabLookup(str, sc);
+  if (sptr != NULL && sptr->level < level) {
+    shadowed = sptr;
+    sptr = NULL;
+  }
   CASSERT(sptr == NULL, ("multiple declarations of %s", str));
 
-  if (sptr != NULL) return sptr;
+  if (sptr != NULL) {
+    PhaseEnd();
+    return sptr;
+  }
 
-  hval = hash(str);
-  
-  sptr = (symtabnode *) zalloc(sizeof(symtabnode));
+  sptr = (symtabnode *) ralloc((sc == Global ? RGN_PROGRAM : RGN_FUNCTION),
+			       sizeof(symtabnode));
   sptr->name = str;
   sptr->scope = sc;
+  sptr->level = level;
+  sptr->ndefs = nFunDefs;
+  if (sc == Global) {
+    sptr->index = nGlobals++;
+  }
+
+  if (shadowed != NULL) {
+    SymTab[sc].slots[FindSlot(sc, shadowed)].stptr = sptr;
+  }
+  else {
+    if (4 * (SymTab[sc].count + 1) > 3 * SymTab[sc].size) {
+      GrowSymTab(sc);
+    }
+    SlotInsert(sc, hash(str), sptr);
+  }
+
+  if (sc == Local) {
+    if (nUndo >= maxUndo) {
+      maxUndo = (maxUndo == 0 ? 64 : 2 * maxUndo);
+      UndoLog = realloc(UndoLog, maxUndo * sizeof(*UndoLog));
+      if (UndoLog == NULL) {
+	fprintf(stderr, "Not enough memory\n");
+	abort();
+      }
+    }
+    UndoLog[nUndo].stptr = sptr;
+    UndoLog[nUndo].shadowed = shadowed;
+    nUndo++;
+  }
   
-  sptr->next = SymTab[sc][hval];
-  SymTab[sc][hval] = sptr;
-  
+  PhaseEnd();
   return sptr;
 }
 
@@ -139,13 +590,28 @@ symtabnode *SymTabRecordFunInfo(bool isProto)
   symtabnode *formal_list_hd, *formal_list_tl, *formal;
   int n;
 
+  PhaseBegin(PH_SYMTAB);
   func = SymTabLookup(fnName, Global);
+  if (GlobalImported) {
+    /*
+     * Parsing a function body on a thread of its own: the function was
+     * recorded by the first pass (see split.c), and the Global table
+     * must not change.  Only the formals go into the Local table.
+     */
+    if (func == NULL) {
+      errmsg("function %s not found by the first pass", fnName);
+      func = ralloc(RGN_FUNCTION, sizeof(*func));
+      func->name = fnName;
+      func->type = t_Func;
+      func->ret_type = fnRetType;
+    }
+  }
   /*
    * It's only OK to have an entry for this ID in the symbol table already
    * if the previous entry was the prototype and this is the actual
    * definition.
    */
-  if (func != NULL) {
+  else if (func != NULL) {
     if (func->fn_proto_state == FN_PROTO && !isProto) {
       /* 
        * the previous definition was a prototype, and this is the
@@ -190,8 +656,10 @@ symtabnode *SymTabRecordFunInfo(bool isProto)
     func = SymTabInsert(fnName, Global);
   }
 
-  func->type = t_Func;
-  func->ret_type = fnRetType;
+  if (!GlobalImported) {
+    func->type = t_Func;
+    func->ret_type = fnRetType;
+  }
 
   formal_list_hd = formal_list_tl = NULL;
 
@@ -210,11 +678,14 @@ symtabnode *SymTabRecordFunInfo(bool isProto)
 	stptr->type = ltmp->type;
 	stptr->elt_type = t_None;
       }
+      if (GlobalImported) {
+	continue;
+      }
       /*
        * Now create a record for the list of formals, and copy over
        * info from stptr.
        */
-      formal = zalloc(sizeof(*formal));
+      formal = ralloc(RGN_PROGRAM, sizeof(*formal));
       formal->name =     stptr->name;
       formal->scope =    stptr->scope;
       formal->formal =   stptr->formal;
@@ -231,6 +702,12 @@ symtabnode *SymTabRecordFunInfo(bool isProto)
     }
   } /* for */
 
+  if (GlobalImported) {
+    fnName = NULL;
+    PhaseEnd();
+    return func;
+  }
+
   func->formals = formal_list_hd;
 
   if (isProto && func->fn_proto_state != FN_DEFINED) {
@@ -243,6 +720,7 @@ symtabnode *SymTabRecordFunInfo(bool isProto)
   func->is_extern = is_extern;
   fnName = NULL;
 
+  PhaseEnd();
   return func;
 }
 
@@ -253,6 +731,16 @@ symtabnode *SymTabRecordFunInfo(bool isProto)
  */
 void CleanupFnInfo(void)
 {
+  PhaseBegin(PH_SYMTAB);
+#ifdef RGNSTATS
+  if (currFun != NULL) {
+    DumpRegionStats(RGN_FUNCTION, currFun->name);
+    DumpSynTreeStats(currFun->name);
+  }
+#endif
+  if (currFun != NULL) {
+    nFunDefs++;
+  }
   fnName = NULL;
   lptr = NULL;
   currFun = NULL;
@@ -260,8 +748,16 @@ void CleanupFnInfo(void)
   CurrScope = Global;
 #if 0
   DumpSymTab(); 
+  DumpSymTabStats(Global);
+  DumpSymTabStats(Local);
 #endif
   SymTabInit(Local);
+  /*
+   * The syntax tree and local symbols of the function are dead now.
+   */
+  RegionReset(RGN_FUNCTION);
+  SynTreeReset();
+  PhaseEnd();
 }
 
 /*********************************************************************
@@ -275,88 +771,88 @@ void printType(symtabnode *stptr)
   symtabnode *formals;
   switch (stptr->type) {
   case t_Char:
-    printf("C");
+    OutPrintf("C");
     CASSERT(stptr->elt_type == t_None, ("<?!>"));
     break;
-  case t_Int:  printf("I");
+  case t_Int:  OutPrintf("I");
     CASSERT(stptr->elt_type == t_None, ("<?!>"));
     break;
   case t_Array:
     switch(stptr->elt_type) {
-    case t_Char: printf("C[%d]", stptr->num_elts); break;
-    case t_Int: printf("I[%d]", stptr->num_elts); break;
-    default: printf("%d?[%d]", stptr->elt_type, stptr->num_elts);
+    case t_Char: OutPrintf("C[%d]", stptr->num_elts); break;
+    case t_Int: OutPrintf("I[%d]", stptr->num_elts); break;
+    default: OutPrintf("%d?[%d]", stptr->elt_type, stptr->num_elts);
     }
     break;
   case t_Func:
-    printf("(");
+    OutPrintf("(");
     if (stptr->formals == NULL) {
-      printf("void");
+      OutPrintf("void");
     }
     else {
       for (formals = stptr->formals; formals; formals = formals->next) {
 	printType(formals);
 	if (formals->next) {
-	  printf(", ");
+	  OutPrintf(", ");
 	}
       }
     }
-    printf(") -> ");
+    OutPrintf(") -> ");
     switch (stptr->ret_type) {
-    case t_Char: printf("C"); break;
-    case t_Int: printf("I"); break;
-    case t_None: printf("void"); break;
-    default: printf("??%d", stptr->ret_type);
+    case t_Char: OutPrintf("C"); break;
+    case t_Int: OutPrintf("I"); break;
+    case t_None: OutPrintf("void"); break;
+    default: OutPrintf("??%d", stptr->ret_type);
     }
     break;
   case t_None:
-    printf("-");
+    OutPrintf("-");
     break;
-  default: printf("?!?%d", stptr->type);
+  default: OutPrintf("?!?%d", stptr->type);
   }
 }
 
 void printSTNode(symtabnode *stptr)
 {
-  printf(">> %s: scope = %c%s; type: ",
-	 stptr->name,
-	 (stptr->scope == Global ? 'G' : 'L'),
-	 (stptr->formal == true ? "<formal param>" : ""));
+  OutPrintf(">> %s: scope = %c%s; type: ",
+	  stptr->name,
+	  (stptr->scope == Global ? 'G' : 'L'),
+	  (stptr->formal == true ? "<formal param>" : ""));
   printType(stptr);
-  printf("\n");
+  OutPrintf("\n");
 }
 
 void DumpSymTabLocal()
 {
-  int i;
+  unsigned i;
   symtabnode *stptr;
 
-  printf("-------------------- LOCAL SYMBOL TABLE --------------------\n");
+  OutPrintf("-------------------- LOCAL SYMBOL TABLE --------------------\n");
 
-  for (i = 0; i < HASHTBLSZ; i++) {
-    for (stptr = SymTab[Local][i]; stptr != NULL; stptr = stptr->next) {
+  for (i = 0; i < SymTab[Local].size; i++) {
+    if ((stptr = SymTab[Local].slots[i].stptr) != NULL) {
       printSTNode(stptr);
     }
   }
 
-  printf("------------------------------------------------------------\n");
+  OutPrintf("------------------------------------------------------------\n");
 
 }
 
 void DumpSymTabGlobal()
 {
-  int i;
+  unsigned i;
   symtabnode *stptr;
 
-  printf("-------------------- GLOBAL SYMBOL TABLE --------------------\n");
+  OutPrintf("-------------------- GLOBAL SYMBOL TABLE --------------------\n");
 
-  for (i = 0; i < HASHTBLSZ; i++) {
-    for (stptr = SymTab[Global][i]; stptr != NULL; stptr = stptr->next) {
+  for (i = 0; i < SymTab[Global].size; i++) {
+    if ((stptr = SymTab[Global].slots[i].stptr) != NULL) {
       printSTNode(stptr);
     }
   }
 
-  printf("------------------------------------------------------------\n");
+  OutPrintf("------------------------------------------------------------\n");
 
 }
 
@@ -366,4 +862,36 @@ void DumpSymTab()
   DumpSymTabLocal();
 }
 
+/*
+ * DumpSymTabStats(sc) -- print the size, load factor and probe lengths
+ * of the hash table for scope sc.  The probe length of an entry is the
+ * number of slots a successful lookup of it examines.
+ */
+void DumpSymTabStats(int sc)
+{
+  unsigned i, dist, maxprobe = 0;
+  long totprobe = 0;
+
+  for (i = 0; i < SymTab[sc].size; i++) {
+    if (SymTab[sc].slots[i].stptr != NULL) {
+      dist = ProbeDist(sc, i);
+      totprobe += dist + 1;
+      if (dist + 1 > maxprobe) {
+	maxprobe = dist + 1;
+      }
+    }
+  }
+
+  OutPrintf("-------------------- %s SYMBOL TABLE STATS --------------------\n",
+	  (sc == Global ? "GLOBAL" : "LOCAL"));
+  OutPrintf("slots: %u; entries: %u; load factor: %.2f\n",
+	  SymTab[sc].size,
+	  SymTab[sc].count,
+	  (SymTab[sc].size == 0 ? 0.0 : (double) SymTab[sc].count / SymTab[sc].size));
+  OutPrintf("probe length: avg %.2f; max %u\n",
+	  (SymTab[sc].count == 0 ? 0.0 : (double) totprobe / SymTab[sc].count),
+	  maxprobe);
+  OutPrintf("------------------------------------------------------------\n");
+}
+
 /*********************************************************************/
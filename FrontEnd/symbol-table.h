@@ -23,6 +23,12 @@ typedef struct stblnode {
   struct stblnode *formals;  /* the list of formals for a function */
   int fn_proto_state;      /* status of prototype definitions for a function */
   bool is_extern;          /* whether or not an ID was declared as an extern */
+  int level;               /* block nesting level of a local; 0 for globals
+			      and locals declared at the top of a function */
+  int ndefs;               /* for a global: no. of function definitions
+			      before its declaration */
+  int index;               /* for a global: its number, in order of
+			      declaration from 0 */
   struct stblnode *next;
 } symtabnode;
 
@@ -33,11 +39,27 @@ typedef struct stblnode {
  *********************************************************************/
 
 void SymTabInit(int sc); // initialize the symbol table at scope sc to empty
+void SymTabFree(void);   // free both tables at the end of a compilation
 symtabnode *SymTabLookup(char *str, int sc); // lookup scope sc
 symtabnode *SymTabLookupAll(char *str); // lookup local first, then global
 symtabnode *SymTabInsert(char *str, int sc);  // add ident to symbol table
+int SymTabEnterScope(void);   // start a block scope within a function
+void SymTabExitScope(int level);  // drop the locals of that block and those inside it
 symtabnode *SymTabRecordFunInfo(bool isProto);
 void CleanupFnInfo(void);
+
+/*
+ * For parsing function bodies on several threads (see split.c), the
+ * Global table of one thread can be used read-only by others.  Only the
+ * globals declared before the ndefs+1'th function definition are
+ * visible then, as if the body were parsed in sequence.
+ */
+struct globaltab;
+struct globaltab *SymTabExportGlobal(void);
+void SymTabImportGlobal(struct globaltab *gt, int ndefs);
+void SymTabSeedGlobal(struct globaltab *gt);  // start with copies of gt's globals
+symtabnode **SymTabGlobals(int *n);  // the globals in order of declaration
+struct globaltab *SymTabMakeGlobal(symtabnode **syms, int n);  // a table of syms
 /*
  * Defugging functions
  */
@@ -45,6 +67,7 @@ void printSTNode(symtabnode *stptr);
 void DumpSymTabLocal();
 void DumpSymTabGlobal();
 void DumpSymTab();
+void DumpSymTabStats(int sc);
 
 /*********************************************************************
  *                                                                   *
@@ -4,12 +4,14 @@
  *
  * Author: Saumya Debray
  */
+#include <limits.h>
 #include <stdarg.h>
-#include "error.h"
+#include <sys/mman.h>
 #include "global.h"
+#include "error.h"
 #include "syntax-tree.h"
 
-static char *nodeTypeName[] =
+char *nodeTypeName[NNODETYPES] =
   {
     "Error",
     "Intcon",
@@ -360,6 +362,461 @@ tnode *stList_Rest(tnode *t)
 }
 
 
+/*********************************************************************
+ *                                                                   *
+ *                           NODE STORAGE                            *
+ *                                                                   *
+ *********************************************************************/
+
+#define MAXNODES  (1 << 26)  /* max. no. of syntax tree nodes in a function */
+#define NKIDS     4          /* no. of children of a statement node */
+
+THREAD_LOCAL tnode *NodeTab;        /* the nodes of the current function */
+THREAD_LOCAL unsigned *NodeKids;    /* children of statement nodes */
+THREAD_LOCAL void **NodePtrs;       /* strings and symbol table entries */
+
+THREAD_LOCAL int FnNodeCount[NNODECOUNTS];
+
+static THREAD_LOCAL unsigned nNodes, nKids, nPtrs;  /* no. of entries in use */
+static THREAD_LOCAL unsigned maxKids, maxPtrs;      /* no. of entries allocated */
+static THREAD_LOCAL treestore *FreeStores;  /* released by SynTreeRelease() */
+
+/*
+ * The hash-consing table for -fshare-exprs (see HASH-CONSING below).
+ */
+#define SHARETABSZ  1024     /* initial no. of entries */
+
+typedef struct {
+  unsigned node;   /* index in NodeTab */
+  unsigned hash;
+  unsigned uses;   /* no. of times the node has been handed out */
+  unsigned gen;    /* the entry is in use if this is ShareGen */
+} shareent;
+
+static THREAD_LOCAL shareent *ShareTab;
+static THREAD_LOCAL unsigned shareSize, shareUsed, ShareGen;
+
+/*
+ * NewNode(ntype, etype) -- return a new node in NodeTab.  The first time
+ * around, or after SynTreeDetach() when there is no storage to reuse,
+ * address space for MAXNODES nodes is reserved; pages only get memory
+ * once they are used, and stay in use for later functions.
+ * Node 0 is never handed out, since index 0 means NULL.
+ */
+static tnode *NewNode(SyntaxNodeType ntype, int etype)
+{
+  tnode *tn;
+
+  if (NodeTab == NULL) {
+    SynTreeReset();
+  }
+  if (NodeTab == NULL) {
+    NodeTab = mmap(NULL, MAXNODES * sizeof(tnode), PROT_READ|PROT_WRITE,
+		   MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0);
+    if (NodeTab == MAP_FAILED) {
+      fprintf(stderr, "Not enough memory\n");
+      abort();
+    }
+  }
+
+  if (nNodes >= MAXNODES) {
+    fprintf(stderr, "[ERROR] more than %d syntax tree nodes in a function\n",
+	    MAXNODES);
+    abort();
+  }
+
+  tn = &NodeTab[nNodes++];
+  CountEvent(CNT_NODES, 1);
+  if (ntype != STnodeList) {
+    FnNodeCount[ntype]++;
+  }
+  tn->ntype = ntype;
+  tn->etype = etype;
+  tn->a = tn->b = 0;
+
+  return tn;
+}
+
+/*
+ * NewKids(x0,x1,x2,x3) -- store children x0, x1, x2, x3 of a statement
+ * node in NodeKids and return the index of the first.  The first NKIDS
+ * entries of NodeKids are 0 and are shared by all nodes without children.
+ */
+static unsigned NewKids(tnode *x0, tnode *x1, tnode *x2, tnode *x3)
+{
+  unsigned k;
+
+  if (x0 == NULL && x1 == NULL && x2 == NULL && x3 == NULL) {
+    return 0;
+  }
+
+  if (nKids + NKIDS > maxKids) {
+    maxKids = 2 * maxKids;
+    NodeKids = realloc(NodeKids, maxKids * sizeof(*NodeKids));
+    if (NodeKids == NULL) {
+      fprintf(stderr, "Not enough memory\n");
+      abort();
+    }
+  }
+
+  k = nKids;
+  NodeKids[k] = NodeIndex(x0);
+  NodeKids[k+1] = NodeIndex(x1);
+  NodeKids[k+2] = NodeIndex(x2);
+  NodeKids[k+3] = NodeIndex(x3);
+  nKids += NKIDS;
+
+  return k;
+}
+
+/*
+ * NewPtr(p) -- store the pointer p in NodePtrs and return its index.
+ */
+static unsigned NewPtr(void *p)
+{
+  if (nPtrs >= maxPtrs) {
+    maxPtrs = 2 * maxPtrs;
+    NodePtrs = realloc(NodePtrs, maxPtrs * sizeof(*NodePtrs));
+    if (NodePtrs == NULL) {
+      fprintf(stderr, "Not enough memory\n");
+      abort();
+    }
+  }
+
+  NodePtrs[nPtrs] = p;
+
+  return nPtrs++;
+}
+
+/*
+ * SynTreeReset() -- discard all syntax tree nodes.  This is called by
+ * CleanupFnInfo() once the tree for a function has been processed.  If
+ * the storage was detached, storage given back by SynTreeRelease() is
+ * reused if there is any.
+ */
+void SynTreeReset(void)
+{
+  treestore *ts;
+
+  if (NodeTab == NULL && (ts = FreeStores) != NULL) {
+    FreeStores = ts->next;
+    free(NodeKids);
+    free(NodePtrs);
+    NodeTab = ts->nodes;
+    NodeKids = ts->kids;
+    NodePtrs = ts->ptrs;
+    maxKids = ts->maxKids;
+    maxPtrs = ts->maxPtrs;
+    free(ts);
+  }
+
+  if (NodeKids == NULL) {
+    maxKids = maxPtrs = 1024;
+    NodeKids = zalloc(maxKids * sizeof(*NodeKids));
+    NodePtrs = zalloc(maxPtrs * sizeof(*NodePtrs));
+  }
+
+  nNodes = 1;
+  nKids = NKIDS;
+  nPtrs = 0;
+  memset(FnNodeCount, 0, sizeof(FnNodeCount));
+  ShareKill();
+}
+
+/*
+ * SynTreeDetach() -- take the nodes of the current function away from
+ * the parser, which gets new storage at the next SynTreeReset().  The
+ * counts of entries in use are left alone, for DumpSynTreeStats().
+ */
+treestore *SynTreeDetach(void)
+{
+  treestore *ts = zalloc(sizeof(treestore));
+
+  ts->nodes = NodeTab;
+  ts->kids = NodeKids;
+  ts->ptrs = NodePtrs;
+  ts->maxKids = maxKids;
+  ts->maxPtrs = maxPtrs;
+  ts->nNodes = nNodes;
+  ts->nKids = nKids;
+  ts->nPtrs = nPtrs;
+  NodeTab = NULL;
+  NodeKids = NULL;
+  NodePtrs = NULL;
+
+  return ts;
+}
+
+/*
+ * SynTreeAttach(ts) -- have the node accessors of the calling thread
+ * look at the detached storage ts, or at nothing if ts is NULL.  The
+ * thread must not build nodes of its own.
+ */
+void SynTreeAttach(treestore *ts)
+{
+  NodeTab = (ts == NULL ? NULL : ts->nodes);
+  NodeKids = (ts == NULL ? NULL : ts->kids);
+  NodePtrs = (ts == NULL ? NULL : ts->ptrs);
+  nNodes = (ts == NULL ? 0 : ts->nNodes);
+  nKids = (ts == NULL ? 0 : ts->nKids);
+  nPtrs = (ts == NULL ? 0 : ts->nPtrs);
+}
+
+/*
+ * SynTreeExtent(nnodes, nkids, nptrs) -- return the number of entries
+ * of NodeTab, NodeKids and NodePtrs in use by the tree the accessors of
+ * the calling thread look at.
+ */
+void SynTreeExtent(unsigned *nnodes, unsigned *nkids, unsigned *nptrs)
+{
+  *nnodes = nNodes;
+  *nkids = nKids;
+  *nptrs = nPtrs;
+}
+
+/*
+ * SynTreeRelease(ts) -- the tree in the detached storage ts is no longer
+ * needed: keep the storage for reuse by SynTreeReset().  Must be called
+ * on the thread that detached it.
+ */
+void SynTreeRelease(treestore *ts)
+{
+  if (ts->nodes == NULL) {
+    free(ts->kids);
+    free(ts->ptrs);
+    free(ts);
+    return;
+  }
+  ts->next = FreeStores;
+  FreeStores = ts;
+}
+
+/*
+ * SynTreeFree() -- give back the memory used for syntax trees, at the
+ * end of a compilation.
+ */
+void SynTreeFree(void)
+{
+  treestore *ts;
+
+  while ((ts = FreeStores) != NULL) {
+    FreeStores = ts->next;
+    munmap(ts->nodes, MAXNODES * sizeof(tnode));
+    free(ts->kids);
+    free(ts->ptrs);
+    free(ts);
+  }
+  if (NodeTab != NULL) {
+    munmap(NodeTab, MAXNODES * sizeof(tnode));
+  }
+  free(NodeKids);
+  free(NodePtrs);
+  NodeTab = NULL;
+  NodeKids = NULL;
+  NodePtrs = NULL;
+  nNodes = nKids = nPtrs = maxKids = maxPtrs = 0;
+  memset(FnNodeCount, 0, sizeof(FnNodeCount));
+  free(ShareTab);
+  ShareTab = NULL;
+  shareSize = shareUsed = ShareGen = 0;
+}
+
+/*
+ * DumpSynTreeStats(label) -- print the number of syntax tree nodes built
+ * since the last reset, and the space they take up, to stderr.
+ */
+void DumpSynTreeStats(char *label)
+{
+  unsigned n = (nNodes == 0 ? 0 : nNodes - 1);
+
+  fprintf(errfp, "@@AST %s: %u nodes, %lu bytes\n",
+	  label,
+	  n,
+	  n * sizeof(tnode)
+	  + (nKids == 0 ? 0 : nKids - NKIDS) * sizeof(*NodeKids)
+	  + nPtrs * sizeof(*NodePtrs));
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                           HASH-CONSING                            *
+ *                                                                   *
+ *********************************************************************/
+
+/*
+ * With -fshare-exprs, the constructors look up each expression without
+ * side effects in ShareTab before building a node for it, and return
+ * the node already built for an identical expression if there is one;
+ * since the children were looked up first, identical means the same
+ * type, value, symbol and children.  The tree becomes a DAG in which a
+ * shared node stands for a value that is computed more than once.  A
+ * function call or an assignment may change what a variable or array
+ * element holds, so building one empties the table, as SynTreeReset()
+ * does at the start of each function.  So does building any other
+ * statement, since the code built next need not be what runs next: an
+ * else part does not run after the then part, and a loop's body runs
+ * again after the parts built after it.  For the same reason the parser
+ * empties the table between the test and the update of a for loop, as
+ * the body runs between them.  FnNodeCount counts each shared node once.
+ *
+ * ShareTab is an open-addressed table with linear probing.  Emptying it
+ * just starts a new generation: entries of older ones count as free.
+ */
+bool share_exprs = false;   /* set from the command line, for all threads */
+
+static const bool Shareable[NNODETYPES] = {
+  [Intcon] = true, [Charcon] = true, [Var] = true, [ArraySubscript] = true,
+  [Plus ... LogicalNot] = true,
+};
+
+/*
+ * ShareHash(ntype, etype, a, b, p) -- the hash of a node with the given
+ * fields, but for a symbol table reference, which has the symbol p.
+ */
+static unsigned ShareHash(int ntype, int etype, unsigned a, unsigned b, void *p)
+{
+  unsigned long long h;
+
+  if (p != NULL) {
+    a = (unsigned) ((unsigned long) p >> 4);
+  }
+  h = ((unsigned long long) ntype << 8 | etype) * 0x9e3779b97f4a7c15ULL;
+  h = (h ^ a) * 0xff51afd7ed558ccdULL;
+  h = (h ^ b) * 0xc4ceb9fe1a85ec53ULL;
+  return (unsigned) (h >> 32);
+}
+
+/*
+ * ShareKill() -- empty ShareTab.
+ */
+void ShareKill(void)
+{
+  if (++ShareGen == 0) {
+    memset(ShareTab, 0, shareSize * sizeof(shareent));
+    ShareGen = 1;
+  }
+  shareUsed = 0;
+}
+
+/*
+ * ShareFind(ntype, etype, a, b, p) -- return the node in ShareTab that
+ * has the given fields (for a symbol table reference, the symbol p), or
+ * NULL if there is none.
+ */
+static tnode *ShareFind(int ntype, int etype, unsigned a, unsigned b, void *p)
+{
+  unsigned h = ShareHash(ntype, etype, a, b, p), i;
+  shareent *ep;
+  tnode *tn;
+
+  if (ShareTab == NULL) {
+    return NULL;
+  }
+  for (i = h & (shareSize - 1); ShareTab[i].gen == ShareGen;
+       i = (i + 1) & (shareSize - 1)) {
+    ep = &ShareTab[i];
+    tn = &NodeTab[ep->node];
+    if (ep->hash == h && tn->ntype == ntype && tn->etype == etype && tn->b == b
+	&& (p != NULL ? NodePtrs[tn->a] == p : tn->a == a)) {
+      ep->uses++;
+      CountEvent(CNT_SHARED, 1);
+      return tn;
+    }
+  }
+  return NULL;
+}
+
+/*
+ * ShareInsert(tab, size, node, hash, uses) -- put an entry in tab, which
+ * has size entries and room for it.
+ */
+static void ShareInsert(shareent *tab, unsigned size,
+			unsigned node, unsigned hash, unsigned uses)
+{
+  unsigned i;
+
+  for (i = hash & (size - 1); tab[i].gen == ShareGen; i = (i + 1) & (size - 1))
+    ;
+  tab[i].node = node;
+  tab[i].hash = hash;
+  tab[i].uses = uses;
+  tab[i].gen = ShareGen;
+}
+
+/*
+ * ShareAdd(tn, p) -- enter the new node tn, a symbol table reference to
+ * p if p is not NULL, in ShareTab, which is doubled in size when half
+ * full.
+ */
+static void ShareAdd(tnode *tn, void *p)
+{
+  shareent *tab;
+  unsigned i, size;
+
+  if (2 * (shareUsed + 1) > shareSize) {
+    size = (shareSize == 0 ? SHARETABSZ : 2 * shareSize);
+    if ((tab = calloc(size, sizeof(shareent))) == NULL) {
+      fprintf(stderr, "Not enough memory\n");
+      abort();
+    }
+    for (i = 0; i < shareSize; i++) {
+      if (ShareTab[i].gen == ShareGen) {
+	ShareInsert(tab, size, ShareTab[i].node, ShareTab[i].hash,
+		    ShareTab[i].uses);
+      }
+    }
+    free(ShareTab);
+    ShareTab = tab;
+    shareSize = size;
+  }
+
+  ShareInsert(ShareTab, shareSize, NodeIndex(tn),
+	      ShareHash(tn->ntype, tn->etype, tn->a, tn->b, p), 1);
+  shareUsed++;
+}
+
+/*
+ * ShareDrop(tn) -- one use of the node tn has gone away.  Returns true
+ * if that was the last, and takes tn out of ShareTab; false if tn is
+ * still in use elsewhere, or can't be found.
+ */
+static bool ShareDrop(tnode *tn)
+{
+  unsigned mask = shareSize - 1, i, j, h, home;
+  void *p = NULL;
+
+  if (ShareTab == NULL) {
+    return false;
+  }
+  if (tn->ntype == Var || tn->ntype == ArraySubscript) {
+    p = NodePtrs[tn->a];
+  }
+  h = ShareHash(tn->ntype, tn->etype, tn->a, tn->b, p);
+  for (i = h & mask; ShareTab[i].node != NodeIndex(tn); i = (i + 1) & mask) {
+    if (ShareTab[i].gen != ShareGen) {
+      return false;
+    }
+  }
+  if (ShareTab[i].gen != ShareGen || --ShareTab[i].uses > 0) {
+    return false;
+  }
+
+  /*
+   * Move later entries of the same run back into the hole, so that
+   * probing still finds them.
+   */
+  for (j = (i + 1) & mask; ShareTab[j].gen == ShareGen; j = (j + 1) & mask) {
+    home = ShareTab[j].hash & mask;
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      ShareTab[i] = ShareTab[j];
+      i = j;
+    }
+  }
+  ShareTab[i].gen = 0;
+  shareUsed--;
+  return true;
+}
+
 /*********************************************************************
  *                                                                   *
  *                       CONSTRUCTOR FUNCTIONS                       *
@@ -371,12 +828,18 @@ tnode *stList_Rest(tnode *t)
  */
 tnode *mkConstNode(SyntaxNodeType ntype, int etype, int n)
 {
-  tnode *tn = zalloc(sizeof(*tn));
+  tnode *tn;
 
-  tn->ntype = ntype;
-  tn->etype = etype;
-  ConstVal(tn) = n;
+  if (share_exprs && (tn = ShareFind(ntype, etype, n, 0, NULL)) != NULL) {
+    return tn;
+  }
+
+  tn = NewNode(ntype, etype);
+  tn->a = n;
 
+  if (share_exprs) {
+    ShareAdd(tn, NULL);
+  }
   return tn;
 }
 
@@ -385,11 +848,9 @@ tnode *mkConstNode(SyntaxNodeType ntype, int etype, int n)
  */
 tnode *mkStrNode(char *s)
 {
-  tnode *tn = zalloc(sizeof(*tn));
+  tnode *tn = NewNode(Stringcon, t_Array);
 
-  tn->ntype = Stringcon;
-  tn->etype = t_Array;
-  StrVal(tn) = s;
+  tn->a = NewPtr(s);
 
   return tn;
 }
@@ -400,14 +861,25 @@ tnode *mkStrNode(char *s)
  */
 tnode *mkSymTabRefNode(SyntaxNodeType ntype, int etype, symtabnode *stptr, tnode *t0)
 {
-  tnode *tn = zalloc(sizeof(*tn));
+  tnode *tn;
 
-  tn->ntype = ntype;
-  tn->etype = etype;
+  if (share_exprs && Shareable[ntype]
+      && (tn = ShareFind(ntype, etype, 0, NodeIndex(t0), stptr)) != NULL) {
+    return tn;
+  }
 
-  SymTabPtr(tn) = stptr;
-  ExprPtr(tn) = t0; 
+  tn = NewNode(ntype, etype);
+  tn->a = NewPtr(stptr);
+  tn->b = NodeIndex(t0);
 
+  if (share_exprs) {
+    if (Shareable[ntype]) {
+      ShareAdd(tn, stptr);
+    }
+    else {
+      ShareKill();   /* a call */
+    }
+  }
   return tn;
 }
 
@@ -417,14 +889,26 @@ tnode *mkSymTabRefNode(SyntaxNodeType ntype, int etype, symtabnode *stptr, tnode
  */
 tnode *mkExprNode(SyntaxNodeType ntype, int etype, tnode *e1, tnode *e2)
 {
-  tnode *tn = zalloc(sizeof(*tn));
+  tnode *tn;
 
-  tn->ntype = ntype;
-  tn->etype = etype;
+  if (share_exprs && Shareable[ntype]
+      && (tn = ShareFind(ntype, etype, NodeIndex(e1), NodeIndex(e2), NULL))
+         != NULL) {
+    return tn;
+  }
 
-  LChild(tn) = e1;
-  RChild(tn) = e2;
+  tn = NewNode(ntype, etype);
+  tn->a = NodeIndex(e1);
+  tn->b = NodeIndex(e2);
 
+  if (share_exprs) {
+    if (Shareable[ntype]) {
+      ShareAdd(tn, NULL);
+    }
+    else {
+      ShareKill();   /* an assignment */
+    }
+  }
   return tn;
 }
 
@@ -439,15 +923,12 @@ tnode *mkSTNode(SyntaxNodeType ntype,
 		  tnode *x2, 
 		  tnode *x3)
 {
-  tnode *tn = zalloc(sizeof(*tn));
+  tnode *tn = NewNode(ntype, etype);
 
-  tn->ntype = ntype;
-  tn->etype = etype;
-
-  Child0(tn) = x0;
-  Child1(tn) = x1;
-  Child2(tn) = x2;
-  Child3(tn) = x3;
+  tn->a = NewKids(x0, x1, x2, x3);
+  if (share_exprs && ntype != Error) {
+    ShareKill();   /* the end of a statement */
+  }
 
   return tn;
 }
@@ -463,17 +944,15 @@ tnode *mkErrorNode(void)
 
 /*
  * mkListNode(hd, tl) -- create a syntax tree node for a list of syntax
- * tree nodes with first element hd and remainder tl.
+ * tree nodes with first element hd and remainder tl.  It is not counted
+ * in FnNodeCount; SeqAppend() counts the lists it starts.
  */
 tnode *mkListNode(tnode *hd, tnode *tl)
 {
-  tnode *tn = zalloc(sizeof(*tn));
-
-  tn->ntype = STnodeList;
-  tn->etype = t_None;
+  tnode *tn = NewNode(STnodeList, t_None);
 
-  LChild(tn) = hd;
-  RChild(tn) = tl;
+  tn->a = NodeIndex(hd);
+  tn->b = NodeIndex(tl);
 
   return tn;
 }
@@ -492,6 +971,7 @@ bool ActualsMatchFormals(symtabnode *fn, tnode *actuals)
   bool err_occurred = false;
 
   assert(fn);
+  PhaseBegin(PH_SEMANTIC);
 
   for (formals = fn->formals, n = 1;
        formals != NULL && actuals != NULL;
@@ -527,17 +1007,101 @@ bool ActualsMatchFormals(symtabnode *fn, tnode *actuals)
 	   fn->name);
   }
 
+  PhaseEnd();
   return !err_occurred;
 }
 
 
 /*
- * SynTreeUnExp(op, e1) -- process a syntax tree for unary expressions.
+ * Constant folding: an operator whose operands are all constants is
+ * replaced by a constant for its value, so that e.g. 2*3+1 builds one
+ * Intcon node rather than five nodes.  Arithmetic is on 32-bit ints,
+ * wrapping around on overflow; a comparison or logical operator gives a
+ * Boolean constant, an Intcon node of type t_Bool with value 0 or 1,
+ * which is itself folded in turn.  A division by a constant 0 (or the
+ * overflowing INT_MIN / -1) is left for run time, the former with a
+ * warning.
+ */
+#define IsConst(e)  ((e)->ntype == Intcon || (e)->ntype == Charcon)
+
+/*
+ * DropConst(e) -- forget the constant node e, which has been folded into
+ * its parent: it no longer counts in FnNodeCount, and if it was the last
+ * node made its slot in NodeTab is reused.  A shared node is only
+ * forgotten once its last use has gone.
+ */
+static void DropConst(tnode *e)
+{
+  if (share_exprs && !ShareDrop(e)) {
+    return;
+  }
+  FnNodeCount[e->ntype]--;
+  if (e == &NodeTab[nNodes-1]) {
+    nNodes--;
+  }
+}
+
+/*
+ * FoldExp(op, etype, e1, e2) -- build the node for the operator op, of
+ * type etype, with the (type-checked) operands e1 and e2 (NULL for a
+ * unary operator); a constant node for its value if they are constants.
+ */
+static tnode *FoldExp(SyntaxNodeType ntype, int etype, tnode *e1, tnode *e2)
+{
+  int a, b, v;
+
+  if (!IsConst(e1) || (e2 != NULL && !IsConst(e2))) {
+    return mkExprNode(ntype, etype, e1, e2);
+  }
+
+  a = e1->a;
+  b = (e2 != NULL ? (int) e2->a : 0);
+
+  switch (ntype) {
+  case UnaryMinus:  v = (int) -(unsigned) a; break;
+  case LogicalNot:  v = !a; break;
+  case Plus:        v = (int) ((unsigned) a + (unsigned) b); break;
+  case BinaryMinus: v = (int) ((unsigned) a - (unsigned) b); break;
+  case Mult:        v = (int) ((unsigned) a * (unsigned) b); break;
+  case Div:
+    if (b == 0) {
+      warnmsg("division by zero");
+      return mkExprNode(ntype, etype, e1, e2);
+    }
+    if (a == INT_MIN && b == -1) {
+      return mkExprNode(ntype, etype, e1, e2);
+    }
+    v = a / b;
+    break;
+  case Equals:      v = (a == b); break;
+  case Neq:         v = (a != b); break;
+  case Leq:         v = (a <= b); break;
+  case Lt:          v = (a < b); break;
+  case Geq:         v = (a >= b); break;
+  case Gt:          v = (a > b); break;
+  case LogicalAnd:  v = (a && b); break;
+  case LogicalOr:   v = (a || b); break;
+  default:
+    return mkExprNode(ntype, etype, e1, e2);
+  }
+
+  if (e2 != NULL) {
+    DropConst(e2);
+  }
+  DropConst(e1);
+  FnNodeCount[FOLDED]++;
+  CountEvent(CNT_FOLDED, 1);
+
+  return mkConstNode(Intcon, etype, v);
+}
+
+/*
+ * CheckUnExp(op, e1) -- process a syntax tree for unary expressions.
  * If the subexpression has appropriate type, construct a syntax tree
  * for the entire expression and return a pointer to this; otherwise
  * give an error message and return a pointer to an error node.
  */
-tnode *SynTreeUnExp(SyntaxNodeType ntype, tnode *e1)
+static tnode *CheckUnExp(SyntaxNodeType ntype, tnode *e1)
 {
   int t1, r1;
   bool err_occurred = false;
@@ -577,18 +1141,18 @@ tnode *SynTreeUnExp(SyntaxNodeType ntype, tnode *e1)
     return mkErrorNode();
   }
   else {
-    return mkExprNode(ntype, r1, e1, NULL);
+    return FoldExp(ntype, r1, e1, NULL);
   }
 }
 
 
 /*
- * SynTreeBinExp(op, e1, e2) -- process a syntax tree for binary expressions.
+ * CheckBinExp(op, e1, e2) -- process a syntax tree for binary expressions.
  * If the subexpressions have appropriate type, construct a syntax tree
  * for the entire expression and return a pointer to this; otherwise
  * give an error message and return a pointer to an error node.
  */
-tnode *SynTreeBinExp(SyntaxNodeType ntype, tnode *e1, tnode *e2)
+static tnode *CheckBinExp(SyntaxNodeType ntype, tnode *e1, tnode *e2)
 {
   int t1, t2;
 
@@ -611,7 +1175,7 @@ tnode *SynTreeBinExp(SyntaxNodeType ntype, tnode *e1, tnode *e2)
   case Mult:          /* arithmetic */
   case Div:           /* arithmetic */
     if ((t1 == t_Int || t1 == t_Char) && (t2 == t_Int || t2 == t_Char)) {
-      return mkExprNode(ntype, t_Int, e1, e2);
+      return FoldExp(ntype, t_Int, e1, e2);
     }
     else {
       errmsg("type error in arithmetic expression");
@@ -626,7 +1190,7 @@ tnode *SynTreeBinExp(SyntaxNodeType ntype, tnode *e1, tnode *e2)
   case Geq:           /* boolean */
   case Gt:            /* boolean */
     if ((t1 == t_Int || t1 == t_Char) && (t2 == t_Int || t2 == t_Char)) {
-      return mkExprNode(ntype, t_Bool, e1, e2);
+      return FoldExp(ntype, t_Bool, e1, e2);
     }
     else {
       errmsg("type error in logical expression");
@@ -637,7 +1201,7 @@ tnode *SynTreeBinExp(SyntaxNodeType ntype, tnode *e1, tnode *e2)
     case LogicalAnd:    /* boolean */
     case LogicalOr:       /* boolean */
     if (t1 == t_Bool && t2 == t_Bool) {
-      return mkExprNode(ntype, t_Bool, e1, e2);
+      return FoldExp(ntype, t_Bool, e1, e2);
     }
     else {
       errmsg("type error in logical expression");
@@ -652,35 +1216,72 @@ tnode *SynTreeBinExp(SyntaxNodeType ntype, tnode *e1, tnode *e2)
 }
 
 /*
- * AppendReturn() -- given a syntax tree for the body of a function
- * (which is a list of syntax trees for statements), it traverses the
- * list to the end and checks to see whether the last element of the 
- * list is a "return".  If not, it appends a Return node at the end
- * of the list.
+ * SynTreeUnExp(op, e1), SynTreeBinExp(op, e1, e2) -- build a syntax
+ * tree for a unary/binary expression, via CheckUnExp()/CheckBinExp(),
+ * charging the time to the semantic checking phase.
  */
-tnode *AppendReturn(tnode *t)
+tnode *SynTreeUnExp(SyntaxNodeType ntype, tnode *e1)
 {
-  tnode *tmp0, *tmp1 = t;
+  tnode *t;
 
-  if (t == NULL) {
-    return mkSTNode(Return, t_None, NULL, NULL, NULL, NULL);
+  PhaseBegin(PH_SEMANTIC);
+  t = CheckUnExp(ntype, e1);
+  PhaseEnd();
+
+  return t;
+}
+
+tnode *SynTreeBinExp(SyntaxNodeType ntype, tnode *e1, tnode *e2)
+{
+  tnode *t;
+
+  PhaseBegin(PH_SEMANTIC);
+  t = CheckBinExp(ntype, e1, e2);
+  PhaseEnd();
+
+  return t;
+}
+
+/*
+ * SeqAppend(s, t) -- append a list node for t to the list under
+ * construction s, using its tail pointer, and return the new list.
+ */
+tnseq SeqAppend(tnseq s, tnode *t)
+{
+  tnode *tn = mkListNode(t, NULL);
+
+  if (s.head == NULL) {
+    s.head = tn;
+    FnNodeCount[STnodeList]++;
+  }
+  else {
+    s.tail->b = NodeIndex(tn);
   }
+  s.tail = tn;
+
+  return s;
+}
 
-  while (tmp1->ntype == STnodeList && ListNext(tmp1) != NULL) {
-    tmp1 = ListNext(tmp1);
+/*
+ * AppendReturn() -- given the list of syntax trees for the statements
+ * in the body of a function, checks to see whether the last element of
+ * the list is a "return".  If not, it appends a Return node at the end
+ * of the list.  An empty body becomes just a Return node.
+ */
+tnode *AppendReturn(tnseq body)
+{
+  tnode *last;
+
+  if (body.head == NULL) {
+    return mkSTNode(Return, t_None, NULL, NULL, NULL, NULL);
   }
-  /*
-   * Check the last tree on the list: if its type is Return, do nothing;
-   * else create a list node containing only a Return node, and attach
-   * this to the end of the list.
-   */    
-  if (ListNode(tmp1)->ntype != Return) {
-    tmp0 = mkListNode(mkSTNode(Return, t_None, NULL, NULL, NULL, NULL),
-		      NULL);
-    ListNext(tmp1) = tmp0;
+
+  last = ListNode(body.tail);
+  if (last == NULL || last->ntype != Return) {
+    body = SeqAppend(body, mkSTNode(Return, t_None, NULL, NULL, NULL, NULL));
   }
 
-  return t;
+  return body.head;
 }
 
 /*********************************************************************
@@ -39,33 +39,89 @@ typedef enum SyntaxNodeType {
   STnodeList
 } SyntaxNodeType; 
 
-struct stref {  // symbol table reference: subscripted expr or function call
-  symtabnode *stptr;
-  struct treenode *exp;
-};
-
-struct expr {  // unary and binary expressions, and expression lists
-  struct treenode *lchild, *rchild;
-};
-
-struct stmt {  // statements
-  struct treenode *child0, *child1, *child2, *child3;
-};
+#define NNODETYPES  (STnodeList + 1)
 
+/*
+ * Syntax tree nodes are kept compact.  The nodes of the function being
+ * compiled live in one contiguous array, NodeTab, and refer to each other
+ * by their 32-bit index in it; index 0 stands for NULL.  A node holds its
+ * type and value type in a byte each, plus two 32-bit fields a and b:
+ *
+ *   Intcon, Charcon:            a = the value
+ *   Stringcon:                  a = index in NodePtrs of the string
+ *   Var, ArraySubscript,        a = index in NodePtrs of the symbol table
+ *   FunCall:                        entry; b = the subexpression (args)
+ *   unary and binary ops,       a = left child; b = right child
+ *   Assg, STnodeList:
+ *   Error, Return, For,         a = index in NodeKids of four consecutive
+ *   While, If:                      children (0 if they are all NULL)
+ *
+ * NodeTab is reserved up front, so a node never moves and a tnode * stays
+ * valid until the array is reset by SynTreeReset() at the end of the
+ * function.  Outside syntax-tree.c, nodes should only be accessed through
+ * the ntype and etype fields and the functions in protos.h.
+ */
 typedef struct treenode {
-  enum SyntaxNodeType ntype;   // the node type for a syntax tree node
-  int etype;  // the type of the value of a syntax tree node, once that
-              // node has been evaluated.  For nodes that don't have a
-              // value, e.g., statements, this is set to t_None.
-  union {
-    int iconst;
-    char *strconst;
-    struct stref strefNode;
-    struct expr exprNode;
-    struct stmt stmtNode;
-  } val;
+  unsigned char ntype;   // the node type for a syntax tree node
+  unsigned char etype;   // the type of the value of a syntax tree node, once
+                         // that node has been evaluated.  For nodes that don't
+                         // have a value, e.g., statements, this is set to t_None.
+  unsigned a, b;         // see above
 } tnode, *tnptr;
 
+/*
+ * A list of syntax trees under construction: the first and last
+ * STnodeList nodes, so that the parser can append in constant time.
+ */
+typedef struct {
+  tnptr head, tail;
+} tnseq;
+
+extern THREAD_LOCAL tnode *NodeTab;
+extern THREAD_LOCAL unsigned *NodeKids;
+extern THREAD_LOCAL void **NodePtrs;
+
+/*
+ * The node storage of a function, taken away from the parser by
+ * SynTreeDetach() so that the tree can be processed on another thread
+ * (see backend.c).  SynTreeAttach() makes it the storage that the
+ * accessors of the calling thread see, and SynTreeRelease() hands it
+ * back to the parser's thread for reuse.
+ */
+typedef struct treestore {
+  tnode *nodes;
+  unsigned *kids;
+  void **ptrs;
+  unsigned maxKids, maxPtrs;
+  unsigned nNodes, nKids, nPtrs;   /* no. of entries in use */
+  struct treestore *next;
+} treestore;
+
+void SynTreeReset(void);
+void SynTreeFree(void);
+treestore *SynTreeDetach(void);
+void SynTreeAttach(treestore *ts);
+void SynTreeRelease(treestore *ts);
+void SynTreeExtent(unsigned *nnodes, unsigned *nkids, unsigned *nptrs);
+void DumpSynTreeStats(char *label);
+
+/*
+ * The no. of nodes of each type built for the current function, counted
+ * by the constructors as they go; an STnodeList is counted once for the
+ * whole list, not for each cell.  The entry after those for the node
+ * types, FOLDED, counts the expressions folded to constants.
+ * SynTreeReset() starts them over.
+ */
+#define FOLDED       NNODETYPES
+#define NNODECOUNTS  (NNODETYPES + 1)
+
+extern THREAD_LOCAL int FnNodeCount[NNODECOUNTS];
+extern char *nodeTypeName[NNODETYPES];
+extern bool node_stats_json;   /* print them as JSON; see process_syntax_tree.c */
+extern bool share_exprs;       /* hash-cons expressions; see syntax-tree.c */
+
+void ShareKill(void);
+
 tnode *mkConstNode(SyntaxNodeType ntype, int etype, int n);
 tnode *mkStrNode(char *s);
 tnode *mkSymTabRefNode(SyntaxNodeType ntype, int etype, symtabnode *stptr, tnode *t0);
@@ -73,27 +129,31 @@ tnode *mkExprNode(SyntaxNodeType ntype, int etype, tnode *e1, tnode *e2);
 tnode *mkSTNode(SyntaxNodeType ntype, int etype, tnode *x0, tnode *x1, tnode *x2, tnode *x3);
 tnode *mkErrorNode(void);
 tnode *mkListNode(tnode *hd, tnode *tl);
-tnode *AppendReturn(tnode *t);
+tnseq SeqAppend(tnseq s, tnode *t);
+tnode *AppendReturn(tnseq body);
 
 bool ActualsMatchFormals(symtabnode *fn, tnode *actuals);
 tnode *SynTreeUnExp(SyntaxNodeType ntype, tnode *e1);
 tnode *SynTreeBinExp(SyntaxNodeType ntype, tnode *e1, tnode *e2);
 
-#define ConstVal(x)   (x)->val.iconst
-#define StrVal(x)     (x)->val.strconst
+#define NodeAt(i)     ((i) == 0 ? NULL : NodeTab + (i))
+#define NodeIndex(t)  ((t) == NULL ? 0 : (unsigned) ((t) - NodeTab))
+
+#define ConstVal(x)   ((int) (x)->a)
+#define StrVal(x)     ((char *) NodePtrs[(x)->a])
 
-#define SymTabPtr(x)  (x)->val.strefNode.stptr
-#define ExprPtr(x)    (x)->val.strefNode.exp
+#define SymTabPtr(x)  ((symtabnode *) NodePtrs[(x)->a])
+#define ExprPtr(x)    NodeAt((x)->b)
 
-#define LChild(x)     (x)->val.exprNode.lchild
-#define RChild(x)     (x)->val.exprNode.rchild
+#define LChild(x)     NodeAt((x)->a)
+#define RChild(x)     NodeAt((x)->b)
 
-#define Child0(x)     (x)->val.stmtNode.child0
-#define Child1(x)     (x)->val.stmtNode.child1
-#define Child2(x)     (x)->val.stmtNode.child2
-#define Child3(x)     (x)->val.stmtNode.child3
+#define Child0(x)     NodeAt(NodeKids[(x)->a])
+#define Child1(x)     NodeAt(NodeKids[(x)->a + 1])
+#define Child2(x)     NodeAt(NodeKids[(x)->a + 2])
+#define Child3(x)     NodeAt(NodeKids[(x)->a + 3])
 
-#define ListNode(x)  (x)->val.exprNode.lchild
-#define ListNext(x)  (x)->val.exprNode.rchild
+#define ListNode(x)  LChild(x)
+#define ListNext(x)  RChild(x)
 
 #endif /* _SYNTAX_TREE_H_ */
@@ -0,0 +1,7 @@
+/*
+ * The body of a function with no statements is a single Return node,
+ * not a list holding one.
+ */
+void k(void) {}
+
+void m(void) { int x; }
@@ -0,0 +1,22 @@
+/*
+ * A syntax error in the declarations of an inner block is recovered
+ * from inside that block: z, declared before the error, is visible up
+ * to the block's closing brace and not after it, the function's own
+ * closing brace is not taken early, and g() is still compiled.
+ */
+void f(void)
+{
+  int a;
+  {
+    int z 5;
+    z = 1;
+  }
+  z = 2;
+  a = 3;
+}
+
+void g(void)
+{
+  int y;
+  y = 4;
+}
@@ -0,0 +1,16 @@
+/*
+ * A syntax error in the declarations at the start of a function body
+ * is recovered from as a bad statement: it gets one error message, and
+ * the rest of the function and g() after it are still compiled.
+ */
+void f(void)
+{
+  int z 5;
+  z = 1;
+}
+
+void g(void)
+{
+  int y;
+  y = 2;
+}
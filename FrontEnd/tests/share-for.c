@@ -0,0 +1,19 @@
+/* options: -fshare-exprs */
+/*
+ * The body of a for loop runs between its test and its update, and
+ * here changes a, so the a+b in the update must not share the node of
+ * the a+b in the test: there are three Plus nodes, not two.  The a+b
+ * in the else part must not share the node of the one in the then
+ * part either, while the one in the then part does share the test's.
+ */
+void f(void)
+{
+  int a, b, x;
+
+  for (a = 0; a+b < 10; x = a+b)
+    a = a+1;
+  if (a+b > 3)
+    x = a+b;
+  else
+    x = a+b;
+}
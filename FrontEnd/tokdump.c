@@ -0,0 +1,38 @@
+/*
+ * tokdump.c -- print the tokens the scanner returns for stdin, one per
+ * line: line number, token code, lexeme and the value of the token (for
+ * identifiers and constants).  Used by "make scancheck" to compare
+ * scanners.
+ */
+
+#include "global.h"
+#include "syntax-tree.h"
+#include "y.tab.h"
+#include "scanner.h"
+
+int main(void)
+{
+  int tok;
+
+  outfp = stdout;
+  errfp = stderr;
+  while ((tok = yylex()) != 0) {
+    printf("%d %d [%s]", linenum, tok, ScanText());
+    switch (tok) {
+    case ID:
+      printf(" %s", id_name);
+      break;
+    case INTCON:
+    case CHARCON:
+      printf(" %d", ival);
+      break;
+    case STRINGCON:
+      printf(" \"%s\"", strval);
+      break;
+    }
+    printf("\n");
+  }
+  printf("%d EOF\n", linenum);
+
+  return 0;
+}
@@ -4,8 +4,12 @@
  * Author: Saumya Debray
  */
 
+#include <stddef.h>
 #include "global.h"
 
+THREAD_LOCAL FILE *outfp, *errfp;
+THREAD_LOCAL jmp_buf *abort_env;
+
 /*
  * return a pointer to a zero-initialized block of n bytes.
  */
@@ -19,6 +23,7 @@ void *zalloc(int n)
   }
 
   ptr = calloc(n, 1);
+  CountEvent(CNT_ZALLOC, n);
 
   if (ptr == NULL) {
     fprintf(stderr, "Not enough memory\n");
@@ -28,6 +33,485 @@ void *zalloc(int n)
   return ptr;
 }
 
+/*
+ * CompileAbort() -- give up on the current compilation after a fatal
+ * error; Compile() then returns -1.  Outside Compile(), exit.
+ */
+void CompileAbort(void)
+{
+  if (abort_env == NULL) {
+    exit(-1);
+  }
+  longjmp(*abort_env, 1);
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                          MEMORY REGIONS                           *
+ *                                                                   *
+ *********************************************************************/
+
+#define NREGIONS     2
+#define RGN_CHUNKSZ  (64*1024)   /* default size of a region chunk */
+#define RGN_ALIGN    8
+
+typedef struct rchunk {
+  struct rchunk *next;
+  char *avail;                  /* first free byte in this chunk */
+  char *limit;                  /* one past the last byte of this chunk */
+} rchunk;
+
+static THREAD_LOCAL struct region {
+  rchunk *first, *curr;
+  long nallocs, nbytes;         /* since the last reset */
+  long tot_allocs, tot_bytes;   /* over the lifetime of the region */
+  long peak_bytes;              /* max. nbytes seen at a reset */
+  long nchunks, chunk_bytes;    /* memory obtained from malloc */
+  int nresets;
+} Regions[NREGIONS];
+
+/*
+ * NewChunk(rp, n) -- get a chunk from malloc with room for at least n
+ * bytes, and link it into region rp after the current chunk.
+ */
+static rchunk *NewChunk(struct region *rp, int n)
+{
+  rchunk *cp;
+  int sz = RGN_CHUNKSZ;
+
+  if (n + (int) sizeof(rchunk) > sz) {
+    sz = n + sizeof(rchunk);
+  }
+
+  cp = malloc(sz);
+  if (cp == NULL) {
+    fprintf(stderr, "Not enough memory\n");
+    abort();
+  }
+  cp->avail = (char *) (cp + 1);
+  cp->limit = (char *) cp + sz;
+
+  if (rp->curr == NULL) {
+    cp->next = NULL;
+    rp->first = cp;
+  }
+  else {
+    cp->next = rp->curr->next;
+    rp->curr->next = cp;
+  }
+
+  rp->nchunks++;
+  rp->chunk_bytes += sz;
+
+  return cp;
+}
+
+/*
+ * ralloc(rgn, n) -- return a pointer to a zero-initialized block of n
+ * bytes in region rgn.  The block goes away when the region is reset.
+ */
+void *ralloc(int rgn, int n)
+{
+  struct region *rp;
+  rchunk *cp;
+  void *ptr;
+
+  if (n <= 0) {
+    fprintf(stderr, "Illegal memory allocation size: %d\n", n);
+    abort();
+  }
+  assert(rgn >= 0 && rgn < NREGIONS);
+
+  rp = &Regions[rgn];
+  n = (n + RGN_ALIGN - 1) & ~(RGN_ALIGN - 1);
+
+  cp = rp->curr;
+  if (cp == NULL || cp->limit - cp->avail < n) {
+    /*
+     * Move on to the next chunk left over from before the last reset
+     * if it is big enough, otherwise get a new one.
+     */
+    if (cp != NULL && cp->next != NULL
+	&& cp->next->limit - (char *) (cp->next + 1) >= n) {
+      cp = cp->next;
+      cp->avail = (char *) (cp + 1);
+    }
+    else {
+      cp = NewChunk(rp, n);
+    }
+    rp->curr = cp;
+  }
+
+  ptr = cp->avail;
+  cp->avail += n;
+  memset(ptr, 0, n);
+
+  rp->nallocs++;
+  rp->nbytes += n;
+  CountEvent(CNT_RALLOC, n);
+
+  return ptr;
+}
+
+/*
+ * RegionReset(rgn) -- release everything allocated in region rgn.  The
+ * chunks are kept around and reused by subsequent allocations.
+ */
+void RegionReset(int rgn)
+{
+  struct region *rp;
+
+  assert(rgn >= 0 && rgn < NREGIONS);
+  rp = &Regions[rgn];
+
+  rp->tot_allocs += rp->nallocs;
+  rp->tot_bytes += rp->nbytes;
+  if (rp->nbytes > rp->peak_bytes) {
+    rp->peak_bytes = rp->nbytes;
+  }
+  rp->nallocs = rp->nbytes = 0;
+  rp->nresets++;
+
+  rp->curr = rp->first;
+  if (rp->curr != NULL) {
+    rp->curr->avail = (char *) (rp->curr + 1);
+  }
+}
+
+/*
+ * RegionFree(rgn) -- release everything allocated in region rgn and
+ * give its chunks back to malloc, at the end of a compilation.
+ */
+void RegionFree(int rgn)
+{
+  struct region *rp;
+  rchunk *cp, *next;
+
+  assert(rgn >= 0 && rgn < NREGIONS);
+  rp = &Regions[rgn];
+
+  for (cp = rp->first; cp != NULL; cp = next) {
+    next = cp->next;
+    free(cp);
+  }
+  memset(rp, 0, sizeof(*rp));
+}
+
+/*
+ * RegionDetach(rgn) -- take the chunks holding everything allocated in
+ * region rgn since it was last reset away from the region, so that the
+ * objects in them outlive the next reset; the region goes on with its
+ * spare chunks, if any.  The allocation counts are left for the next
+ * reset.  The chunks must be given back with RegionReclaim() before the
+ * region is freed.
+ */
+struct rchunk *RegionDetach(int rgn)
+{
+  struct region *rp;
+  rchunk *cp;
+
+  assert(rgn >= 0 && rgn < NREGIONS);
+  rp = &Regions[rgn];
+
+  if (rp->curr == NULL) {
+    return NULL;
+  }
+  cp = rp->first;
+  rp->first = rp->curr->next;
+  rp->curr->next = NULL;
+
+  rp->curr = rp->first;
+  if (rp->curr != NULL) {
+    rp->curr->avail = (char *) (rp->curr + 1);
+  }
+
+  return cp;
+}
+
+/*
+ * RegionReclaim(rgn, chunks) -- the objects in chunks, which came from
+ * RegionDetach(rgn), are dead: put the chunks back in region rgn as
+ * spares.  Must be called on the thread that detached them.
+ */
+void RegionReclaim(int rgn, struct rchunk *chunks)
+{
+  struct region *rp;
+  rchunk *last;
+
+  assert(rgn >= 0 && rgn < NREGIONS);
+  rp = &Regions[rgn];
+
+  if (chunks == NULL) {
+    return;
+  }
+  for (last = chunks; last->next != NULL; last = last->next) {
+    continue;
+  }
+
+  if (rp->curr == NULL) {
+    last->next = rp->first;
+    rp->first = rp->curr = chunks;
+    chunks->avail = (char *) (chunks + 1);
+  }
+  else {
+    last->next = rp->curr->next;
+    rp->curr->next = chunks;
+  }
+}
+
+/*
+ * DumpRegionStats(rgn, label) -- print the number of allocations and
+ * bytes allocated in region rgn since it was last reset, to stderr.
+ */
+void DumpRegionStats(int rgn, char *label)
+{
+  struct region *rp;
+
+  assert(rgn >= 0 && rgn < NREGIONS);
+  rp = &Regions[rgn];
+
+  fprintf(errfp, "@@RGN %s: %ld allocs, %ld bytes\n",
+	  label, rp->nallocs, rp->nbytes);
+}
+
+/*
+ * DumpRegionTotals(rgn, label) -- print allocation statistics for
+ * region rgn over its whole lifetime, to stderr.
+ */
+void DumpRegionTotals(int rgn, char *label)
+{
+  struct region *rp;
+
+  assert(rgn >= 0 && rgn < NREGIONS);
+  rp = &Regions[rgn];
+
+  fprintf(errfp, "@@RGN %s: %d resets, %ld allocs, %ld bytes total, %ld bytes peak\n",
+	  label,
+	  rp->nresets,
+	  rp->tot_allocs + rp->nallocs,
+	  rp->tot_bytes + rp->nbytes,
+	  (rp->nbytes > rp->peak_bytes ? rp->nbytes : rp->peak_bytes));
+  fprintf(errfp, "@@RGN %s: %ld chunks, %ld bytes reserved\n",
+	  label, rp->nchunks, rp->chunk_bytes);
+}
+
+/*********************************************************************
+ *                                                                   *
+ *                               ATOMS                               *
+ *                                                                   *
+ *********************************************************************/
+
+#define ATOMTBLSZ_INIT  1024
+
+typedef struct atom {
+  struct atom *next;
+  unsigned hash;
+  int len;
+  char name[];                  /* the spelling, NUL-terminated */
+} atom;
+
+#define AtomOf(s)  ((atom *) ((s) - offsetof(atom, name)))
+
+static THREAD_LOCAL atom **AtomTab;
+static THREAD_LOCAL unsigned AtomTabSz;   /* always a power of 2 */
+static THREAD_LOCAL long nAtoms;          /* no. of distinct atoms */
+static THREAD_LOCAL long nInterns;        /* no. of calls to Intern() */
+static THREAD_LOCAL long nAtomBytes;      /* space used by atoms */
+
+/*
+ * The atom tables of other threads that Intern() looks in first, if
+ * any: see AtomTabImport().  An exported table is chained to the tables
+ * its own thread looked in, so that these are searched too.
+ */
+struct atomtab {
+  atom **tab;
+  unsigned size;
+  struct atomtab *next;
+};
+static THREAD_LOCAL struct atomtab *SharedAtoms;
+
+/*
+ * StrHash(s, len) -- FNV-1a hash of the len bytes starting at s.
+ */
+static unsigned StrHash(char *s, int len)
+{
+  unsigned h = 2166136261u;
+
+  while (len-- > 0) {
+    h ^= (unsigned char) *s++;
+    h *= 16777619u;
+  }
+
+  return h;
+}
+
+/*
+ * GrowAtomTab() -- double the size of the atom table and rehash.
+ */
+static void GrowAtomTab(void)
+{
+  atom **newtab, *ap, *next;
+  unsigned i, newsz = (AtomTabSz == 0 ? ATOMTBLSZ_INIT : 2 * AtomTabSz);
+
+  newtab = zalloc(newsz * sizeof(atom *));
+
+  for (i = 0; i < AtomTabSz; i++) {
+    for (ap = AtomTab[i]; ap != NULL; ap = next) {
+      next = ap->next;
+      ap->next = newtab[ap->hash & (newsz - 1)];
+      newtab[ap->hash & (newsz - 1)] = ap;
+    }
+  }
+
+  free(AtomTab);
+  AtomTab = newtab;
+  AtomTabSz = newsz;
+}
+
+/*
+ * Intern(s, len) -- return the atom for the len characters starting
+ * at s, creating it (in RGN_PROGRAM) if it does not exist yet.
+ */
+char *Intern(char *s, int len)
+{
+  struct atomtab *at;
+  atom *ap;
+  unsigned h = StrHash(s, len);
+
+  nInterns++;
+
+  for (at = SharedAtoms; at != NULL; at = at->next) {
+    if (at->tab == NULL) {
+      continue;
+    }
+    for (ap = at->tab[h & (at->size - 1)]; ap != NULL; ap = ap->next) {
+      if (ap->hash == h && ap->len == len && memcmp(ap->name, s, len) == 0) {
+	return ap->name;
+      }
+    }
+  }
+
+  if (nAtoms >= AtomTabSz) {
+    GrowAtomTab();
+  }
+
+  for (ap = AtomTab[h & (AtomTabSz - 1)]; ap != NULL; ap = ap->next) {
+    if (ap->hash == h && ap->len == len && memcmp(ap->name, s, len) == 0) {
+      return ap->name;
+    }
+  }
+
+  ap = ralloc(RGN_PROGRAM, sizeof(atom) + len + 1);
+  ap->hash = h;
+  ap->len = len;
+  memcpy(ap->name, s, len);
+  ap->next = AtomTab[h & (AtomTabSz - 1)];
+  AtomTab[h & (AtomTabSz - 1)] = ap;
+
+  nAtoms++;
+  nAtomBytes += sizeof(atom) + len + 1;
+
+  return ap->name;
+}
+
+/*
+ * AtomTabFree() -- empty the atom table.  The atoms themselves are in
+ * RGN_PROGRAM, so this goes together with resetting that region.
+ */
+void AtomTabFree(void)
+{
+  free(AtomTab);
+  AtomTab = NULL;
+  AtomTabSz = 0;
+  nAtoms = nInterns = nAtomBytes = 0;
+}
+
+/*
+ * AtomTabExport() -- return a description of the atom table of the
+ * calling thread, for AtomTabImport() on other threads.  No atoms may
+ * be added to the table while they use it.
+ */
+struct atomtab *AtomTabExport(void)
+{
+  struct atomtab *at = zalloc(sizeof(struct atomtab));
+
+  at->tab = AtomTab;
+  at->size = AtomTabSz;
+  at->next = SharedAtoms;
+
+  return at;
+}
+
+/*
+ * AtomTabImport(at) -- have Intern() on the calling thread return the
+ * atoms in the table at of another thread where there are any, so that
+ * they compare equal to the atoms of that thread; new atoms are still
+ * added to the calling thread's own table.  If at is NULL, stop doing so.
+ */
+void AtomTabImport(struct atomtab *at)
+{
+  SharedAtoms = at;
+}
+
+/*
+ * AtomTabMake(names, n) -- make a table of atoms for the n strings in
+ * names, apart from the atom table of any thread and in memory of its
+ * own, for AtomTabImport() by any number of threads (see pch.c); each
+ * entry of names is replaced by its atom.  The table is never freed.
+ */
+struct atomtab *AtomTabMake(char **names, int n)
+{
+  struct atomtab *at = zalloc(sizeof(struct atomtab));
+  atom *ap;
+  unsigned h;
+  int i, len;
+
+  for (at->size = 64; at->size < (unsigned) n; at->size *= 2) {
+    continue;
+  }
+  at->tab = zalloc(at->size * sizeof(atom *));
+
+  for (i = 0; i < n; i++) {
+    len = strlen(names[i]);
+    h = StrHash(names[i], len);
+    for (ap = at->tab[h & (at->size - 1)]; ap != NULL; ap = ap->next) {
+      if (ap->hash == h && ap->len == len && memcmp(ap->name, names[i], len) == 0) {
+	break;
+      }
+    }
+    if (ap == NULL) {
+      ap = zalloc(sizeof(atom) + len + 1);
+      ap->hash = h;
+      ap->len = len;
+      memcpy(ap->name, names[i], len);
+      ap->next = at->tab[h & (at->size - 1)];
+      at->tab[h & (at->size - 1)] = ap;
+    }
+    names[i] = ap->name;
+  }
+
+  return at;
+}
+
+/*
+ * AtomHash(s) -- given an atom s, i.e., a string returned by Intern(),
+ * return its hash value.
+ */
+unsigned AtomHash(char *s)
+{
+  return AtomOf(s)->hash;
+}
+
+/*
+ * DumpAtomStats() -- print the number of identifiers interned, the number
+ * of distinct atoms, and the space they take up, to stderr.
+ */
+void DumpAtomStats(void)
+{
+  fprintf(errfp, "@@ATOM: %ld identifiers, %ld unique, %ld bytes\n",
+	  nInterns, nAtoms, nAtomBytes);
+}
+
 /*
  * NewListNode(x, type, is_array) -- allocate a new linked list node 
  * and set its fields appropriately;
@@ -36,7 +520,7 @@ llistptr NewListNode(char *str, int Type, bool arr)
 {
   llistptr ltmp;
 
-  ltmp = zalloc(sizeof(*ltmp));
+  ltmp = ralloc(RGN_FUNCTION, sizeof(*ltmp));
   ltmp->name = str;
   ltmp->type = Type;
   ltmp->is_array = arr;
@@ -45,21 +529,23 @@ llistptr NewListNode(char *str, int Type, bool arr)
 }
 
 /*
- * Attach(list1, list2) -- given two linked lists, attaches the second 
- * at the end of the first.
+ * LSeqAppend(s, l) -- attaches the list l at the end of the list under
+ * construction s, and returns the resulting list.  The tail pointer of s
+ * is followed to the end of l, so appending single elements one at a
+ * time takes constant time each.
  */
-llistptr Attach(llistptr list1, llistptr list2)
+llseq LSeqAppend(llseq s, llistptr l)
 {
-  llistptr ltmp;
+  if (l == NULL) return s;
 
-  if (list1 == NULL) return list2;
-  /*
-   * find the last element of the list.
-   */
-  for (ltmp = list1; ltmp != NULL && ltmp->next != NULL; ltmp = ltmp->next) {
+  if (s.head == NULL) {
+    s.head = l;
+  }
+  else {
+    s.tail->next = l;
+  }
+  for (s.tail = l; s.tail->next != NULL; s.tail = s.tail->next) {
   }
-  
-  ltmp->next = list2;
 
-  return list1;
+  return s;
 }
@@ -9,7 +9,55 @@ typedef struct lnode {
   struct lnode *next;
 } llist, *llistptr;
 
+/*
+ * A linked list under construction, with a pointer to its last element.
+ */
+typedef struct {
+  llistptr head, tail;
+} llseq;
+
 void *zalloc(int n);
 
+/*
+ * Where the current compilation writes its output and its error
+ * messages, and how it gives up on a fatal error (see Compile()).
+ */
+extern THREAD_LOCAL FILE *outfp, *errfp;
+extern THREAD_LOCAL jmp_buf *abort_env;
+void CompileAbort(void);
+
+/*
+ * Memory regions.  Objects whose lifetime ends with the current function
+ * (syntax tree nodes, local symbol table entries, parameter lists) are
+ * allocated in RGN_FUNCTION, which is reset by CleanupFnInfo(); objects
+ * that live for the whole program (global symbols, formals lists of
+ * functions) are allocated in RGN_PROGRAM.  RegionDetach() lets the
+ * objects of a function live on after the reset, e.g. while its tree is
+ * processed on another thread.
+ */
+#define RGN_PROGRAM   0
+#define RGN_FUNCTION  1
+
+void *ralloc(int rgn, int n);
+void RegionReset(int rgn);
+void RegionFree(int rgn);
+struct rchunk *RegionDetach(int rgn);
+void RegionReclaim(int rgn, struct rchunk *chunks);
+void DumpRegionStats(int rgn, char *label);
+void DumpRegionTotals(int rgn, char *label);
+
+/*
+ * Atoms: interned identifier spellings.  Intern() returns the unique
+ * copy of a string, so atoms can be compared with ==; AtomHash() returns
+ * the hash value computed when the atom was created.
+ */
+char *Intern(char *s, int len);
+unsigned AtomHash(char *atom);
+void AtomTabFree(void);
+struct atomtab *AtomTabExport(void);
+void AtomTabImport(struct atomtab *at);
+struct atomtab *AtomTabMake(char **names, int n);
+void DumpAtomStats(void);
+
 llistptr NewListNode(char *str, int Type, bool arr);
-llistptr Attach(llistptr list1, llistptr list2);
+llseq LSeqAppend(llseq s, llistptr l);
@@ -0,0 +1,174 @@
+/*
+ * walk.c -- walking syntax trees without recursion (see walk.h).
+ */
+
+#include "global.h"
+#include "protos.h"
+#include "syntax-tree.h"
+#include "walk.h"
+
+#define WALK_STACKSZ  256     /* initial no. of frames */
+
+/*
+ * The no. of children of a node of each type, but for STnodeList, whose
+ * children are counted by following its cells.
+ */
+static const unsigned char NKids[NNODETYPES] = {
+  [ArraySubscript] = 1,
+  [Plus] = 2, [UnaryMinus] = 1, [BinaryMinus] = 2, [Mult] = 2, [Div] = 2,
+  [Equals] = 2, [Neq] = 2, [Leq] = 2, [Lt] = 2, [Geq] = 2, [Gt] = 2,
+  [LogicalAnd] = 2, [LogicalOr] = 2, [LogicalNot] = 1,
+  [FunCall] = 1, [Assg] = 2, [Return] = 1,
+  [For] = 4, [While] = 2, [If] = 3,
+};
+
+/*
+ * Kid(t, i) -- the i-th child of t, which is not an STnodeList.
+ */
+static tnode *Kid(tnode *t, int i)
+{
+  switch (t->ntype) {
+  case ArraySubscript:
+    return stArraySubscript_Subscript(t);
+  case UnaryMinus:
+  case LogicalNot:
+    return stUnop_Op(t);
+  case FunCall:
+    return stFunCall_Args(t);
+  case Assg:
+    return (i == 0 ? stAssg_Lhs(t) : stAssg_Rhs(t));
+  case Return:
+    return stReturn(t);
+  case For:
+    switch (i) {
+    case 0: return stFor_Init(t);
+    case 1: return stFor_Test(t);
+    case 2: return stFor_Update(t);
+    default: return stFor_Body(t);
+    }
+  case While:
+    return (i == 0 ? stWhile_Test(t) : stWhile_Body(t));
+  case If:
+    switch (i) {
+    case 0: return stIf_Test(t);
+    case 1: return stIf_Then(t);
+    default: return stIf_Else(t);
+    }
+  default:
+    return (i == 0 ? stBinop_Op1(t) : stBinop_Op2(t));
+  }
+}
+
+/*
+ * NextKid(f, kid) -- if the node of frame f has another child, set *kid
+ * to it and f->kid to its position, and return true.
+ */
+static bool NextKid(walkframe *f, tnode **kid)
+{
+  tnode *t = f->t;
+
+  if (t == NULL || f->next < 0) {
+    return false;
+  }
+  if (t->ntype == STnodeList) {
+    if (f->rest == NULL) {
+      f->next = -1;
+      return false;
+    }
+    *kid = stList_Head(f->rest);
+    f->rest = stList_Rest(f->rest);
+  }
+  else if (f->next < NKids[t->ntype]) {
+    *kid = Kid(t, f->next);
+  }
+  else {
+    f->next = -1;
+    return false;
+  }
+  f->kid = f->next++;
+  return true;
+}
+
+/*
+ * Enter(w, f, t, depth, arg) -- fill in the frame f for the node t and
+ * call the pre (or null) function of w for it.
+ */
+static walkaction Enter(const walker *w, walkframe *f, tnode *t, int depth, int arg)
+{
+  walkfn fn;
+
+  assert(t == NULL || t->ntype < NNODETYPES);
+
+  f->t = t;
+  f->depth = depth;
+  f->arg = f->kidarg = arg;
+  f->kid = 0;
+  f->next = 0;
+  f->rest = t;
+  fn = (t == NULL ? w->null : w->pre[t->ntype]);
+  return (fn != NULL ? fn(f) : WALK_CONTINUE);
+}
+
+/*
+ * WalkTree(w, t, depth, arg) -- walk the tree t with the walker w, as
+ * described in walk.h.  The frame of t gets the given depth and arg.
+ * Returns false if the walk was ended by WALK_STOP.
+ */
+bool WalkTree(const walker *w, tnode *t, int depth, int arg)
+{
+  walkframe *stack, *f;
+  int size = WALK_STACKSZ, sp = 0;
+  walkaction act;
+  walkfn fn;
+  tnode *kid;
+
+  if ((stack = malloc(size * sizeof(walkframe))) == NULL) {
+    fprintf(stderr, "Not enough memory\n");
+    abort();
+  }
+
+  act = Enter(w, &stack[0], t, depth, arg);
+  while (act != WALK_STOP) {
+    f = &stack[sp];
+    if (act == WALK_SKIP) {
+      f->next = -1;
+    }
+
+    if (NextKid(f, &kid)) {
+      fn = w->child[f->t->ntype];
+      if (fn != NULL && (act = fn(f)) != WALK_CONTINUE) {
+	if (act == WALK_SKIP) {
+	  act = WALK_CONTINUE;
+	}
+	continue;
+      }
+      if (kid == NULL && w->null == NULL) {
+	act = WALK_CONTINUE;
+	continue;
+      }
+      if (++sp == size) {
+	size *= 2;
+	if ((stack = realloc(stack, size * sizeof(walkframe))) == NULL) {
+	  fprintf(stderr, "Not enough memory\n");
+	  abort();
+	}
+	f = &stack[sp - 1];
+      }
+      act = Enter(w, &stack[sp], kid, f->depth + 1, f->kidarg);
+      continue;
+    }
+
+    act = WALK_CONTINUE;
+    if (f->t != NULL && (fn = w->post[f->t->ntype]) != NULL) {
+      act = fn(f);
+    }
+    if (act == WALK_STOP || sp == 0) {
+      break;
+    }
+    sp--;
+    act = WALK_CONTINUE;
+  }
+
+  free(stack);
+  return (act != WALK_STOP);
+}
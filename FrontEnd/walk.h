@@ -0,0 +1,52 @@
+/*
+ * walk.h -- walking syntax trees without recursion.
+ *
+ * WalkTree() visits a tree in depth-first order, keeping the path from
+ * the root in a stack of frames on the heap rather than on the C stack,
+ * so that a chain of 200000 additions or a deeply nested if-else is no
+ * more trouble than a small tree.  What is done at each node is given by
+ * a walker: tables, indexed by node type, of functions called before the
+ * children of a node (pre), before each of its children (child), and
+ * after them (post).  A missing child, e.g. the else-part of an if
+ * without one, is passed to the null function if there is one, and
+ * otherwise left out.  Any of the functions may be NULL.
+ *
+ * The children of a node are those given by the accessors in protos.h,
+ * in the order they appear in the source; those of an STnodeList are the
+ * heads of all of its cells.  Leaves and Error nodes have none.
+ *
+ * The value returned by a function controls the walk:
+ *
+ *   WALK_CONTINUE   go on as usual.
+ *   WALK_SKIP       from pre, skip the children (post is still called);
+ *                   from child, skip that child.
+ *   WALK_STOP       end the walk at once.
+ */
+
+#ifndef _WALK_H_
+#define _WALK_H_
+
+typedef enum { WALK_CONTINUE, WALK_SKIP, WALK_STOP } walkaction;
+
+typedef struct walkframe {
+  tnode *t;           /* the node; NULL for a missing child */
+  int depth;          /* the depth of the root plus the no. of ancestors */
+  int arg;            /* for the walker's use; starts as the parent's kidarg */
+  int kidarg;         /* arg for the children; starts as arg */
+  int kid;            /* in child and below: the child being visited */
+  int next;           /* the next child, or -1 after the last */
+  tnode *rest;        /* of an STnodeList: the cells after child kid */
+} walkframe;
+
+typedef walkaction (*walkfn)(walkframe *f);
+
+typedef struct walker {
+  walkfn pre[NNODETYPES];
+  walkfn child[NNODETYPES];
+  walkfn post[NNODETYPES];
+  walkfn null;
+} walker;
+
+bool WalkTree(const walker *w, tnode *t, int depth, int arg);
+
+#endif  /* _WALK_H_ */
@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
+/* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -36,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -43,86 +45,61 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.3"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
+/* Push parsers.  */
+#define YYPUSH 0
 
+/* Pull parsers.  */
+#define YYPULL 1
 
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     ID = 258,
-     INTCON = 259,
-     CHARCON = 260,
-     STRINGCON = 261,
-     CHAR = 262,
-     INT = 263,
-     VOID = 264,
-     EXTERN = 265,
-     IF = 266,
-     ELSE = 267,
-     WHILE = 268,
-     FOR = 269,
-     RETURN = 270,
-     AND = 271,
-     OR = 272,
-     EQ = 273,
-     NEQ = 274,
-     LE = 275,
-     GE = 276,
-     dangling_else = 277
-   };
-#endif
-/* Tokens.  */
-#define ID 258
-#define INTCON 259
-#define CHARCON 260
-#define STRINGCON 261
-#define CHAR 262
-#define INT 263
-#define VOID 264
-#define EXTERN 265
-#define IF 266
-#define ELSE 267
-#define WHILE 268
-#define FOR 269
-#define RETURN 270
-#define AND 271
-#define OR 272
-#define EQ 273
-#define NEQ 274
-#define LE 275
-#define GE 276
-#define dangling_else 277
-
-
-
-
-/* Copy the first part of user declarations.  */
+
+
+/* First part of user prologue.  */
 #line 13 "parser.y"
 
 #include "global.h"
 #include "error.h"
 #include "syntax-tree.h"
 #include "symbol-table.h"
+#include "scanner.h"
+#include "backend.h"
 
-extern int yylex();
-extern void yyerror();
+/*
+ * The parser is pure (it keeps its stacks and lookahead in local
+ * variables) so that it can run on several threads at once.  The scanner
+ * returns token values in globals rather than through yylval, so the
+ * arguments that a pure parser passes to yylex() are dropped.  Syntax
+ * errors are reported with the lookahead token, which is local to
+ * yyparse().
+ *
+ * For the statistics in stats.c: tokens are counted (and the scanner
+ * timed) by TimedLex(), which stands in for yylex(), and reductions are
+ * counted by a CountEvent() that the Makefile puts at the start of the
+ * reduction code in y.tab.c, since yacc offers no hook there.
+ */
+extern int TimedLex(void);
+#define yylex(lvalp)  TimedLex()
+#define yyerror(s)    SyntaxError(s, yychar)
+
+/*
+ * A fatal error in the scanner leaves yyparse() by CompileAbort()'s
+ * longjmp(), so the stacks must never be moved to the heap, where they
+ * would then leak; they start out at their maximum size instead.
+ */
+#define YYMAXDEPTH   10000
+#define YYINITDEPTH  YYMAXDEPTH
 
 /*
  * The function process_syntax_tree() is defined in the file 
@@ -134,106 +111,301 @@ extern void yyerror();
  * body.
  *
  * Syntax tree processing can be customized by replacing the code for
- * this function.
+ * this function.  It is called through BackendSubmit() (backend.c),
+ * which may run it on another thread while parsing goes on.
  */
-extern void process_syntax_tree(symtabnode *fn_name, struct treenode *fn_body);
 
   /*
    * struct treenode *currfnbodyTree is set to point to
    * the syntax tree for the body of the current function
    * at the end of each function.  
-   * NOTE: the syntax tree MUST be used before CleanupFnInfo()
-   * is called at the end of the function.  After that the
-   * symbol table entries for the local variables of the
-   * function will go away, leaving dangling pointers from
-   * the syntax tree.
+   * NOTE: the syntax tree MUST be used, or handed to
+   * BackendSubmit(), before CleanupFnInfo() is called at the
+   * end of the function.  After that the symbol table entries
+   * for the local variables of the function will go away,
+   * leaving dangling pointers from the syntax tree.
    */
-struct treenode *currfnbodyTree = NULL;
-
-extern char *id_name, *yytext;
-extern int ival;
-extern int linenum;
-char *fnName;
-symtabnode *stptr, *currFun;
-int CurrType, EltType, fnRetType;
-int CurrScope = Global;
-llistptr lptr;
-bool is_extern;
-int errstate = 0;
-
+THREAD_LOCAL struct treenode *currfnbodyTree = NULL;
+
+THREAD_LOCAL char *fnName;
+THREAD_LOCAL symtabnode *stptr, *currFun;
+THREAD_LOCAL int CurrType, EltType, fnRetType;
+THREAD_LOCAL int CurrScope = Global;
+THREAD_LOCAL llistptr lptr;
+THREAD_LOCAL bool is_extern;
+THREAD_LOCAL int errstate = 0;
+
+#line 139 "y.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-/* Enabling traces.  */
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
+#ifndef YY_YY_Y_TAB_H_INCLUDED
+# define YY_YY_Y_TAB_H_INCLUDED
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
 #endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
+#if YYDEBUG
+extern int yydebug;
 #endif
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    ID = 258,                      /* ID  */
+    INTCON = 259,                  /* INTCON  */
+    CHARCON = 260,                 /* CHARCON  */
+    STRINGCON = 261,               /* STRINGCON  */
+    CHAR = 262,                    /* CHAR  */
+    INT = 263,                     /* INT  */
+    VOID = 264,                    /* VOID  */
+    EXTERN = 265,                  /* EXTERN  */
+    IF = 266,                      /* IF  */
+    ELSE = 267,                    /* ELSE  */
+    WHILE = 268,                   /* WHILE  */
+    FOR = 269,                     /* FOR  */
+    RETURN = 270,                  /* RETURN  */
+    AND = 271,                     /* AND  */
+    OR = 272,                      /* OR  */
+    EQ = 273,                      /* EQ  */
+    NEQ = 274,                     /* NEQ  */
+    LE = 275,                      /* LE  */
+    GE = 276,                      /* GE  */
+    dangling_else = 277            /* dangling_else  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 60 "parser.y"
+union YYSTYPE
 {
+#line 83 "parser.y"
+
   tnptr tptr;
   llistptr idlistptr;
+  llseq idseq;
+  tnseq tseq;
   char *chptr;
   int nval;
-}
-/* Line 193 of yacc.c.  */
-#line 194 "y.tab.c"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+
+#line 220 "y.tab.c"
+
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
 
 
 
-/* Copy the second part of user declarations.  */
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_Y_TAB_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_ID = 3,                         /* ID  */
+  YYSYMBOL_INTCON = 4,                     /* INTCON  */
+  YYSYMBOL_CHARCON = 5,                    /* CHARCON  */
+  YYSYMBOL_STRINGCON = 6,                  /* STRINGCON  */
+  YYSYMBOL_CHAR = 7,                       /* CHAR  */
+  YYSYMBOL_INT = 8,                        /* INT  */
+  YYSYMBOL_VOID = 9,                       /* VOID  */
+  YYSYMBOL_EXTERN = 10,                    /* EXTERN  */
+  YYSYMBOL_IF = 11,                        /* IF  */
+  YYSYMBOL_ELSE = 12,                      /* ELSE  */
+  YYSYMBOL_WHILE = 13,                     /* WHILE  */
+  YYSYMBOL_FOR = 14,                       /* FOR  */
+  YYSYMBOL_RETURN = 15,                    /* RETURN  */
+  YYSYMBOL_AND = 16,                       /* AND  */
+  YYSYMBOL_OR = 17,                        /* OR  */
+  YYSYMBOL_EQ = 18,                        /* EQ  */
+  YYSYMBOL_NEQ = 19,                       /* NEQ  */
+  YYSYMBOL_LE = 20,                        /* LE  */
+  YYSYMBOL_GE = 21,                        /* GE  */
+  YYSYMBOL_22_ = 22,                       /* '<'  */
+  YYSYMBOL_23_ = 23,                       /* '>'  */
+  YYSYMBOL_24_ = 24,                       /* '='  */
+  YYSYMBOL_25_ = 25,                       /* '!'  */
+  YYSYMBOL_26_ = 26,                       /* '+'  */
+  YYSYMBOL_27_ = 27,                       /* '-'  */
+  YYSYMBOL_28_ = 28,                       /* '*'  */
+  YYSYMBOL_29_ = 29,                       /* '/'  */
+  YYSYMBOL_30_ = 30,                       /* ','  */
+  YYSYMBOL_31_ = 31,                       /* '('  */
+  YYSYMBOL_32_ = 32,                       /* ')'  */
+  YYSYMBOL_33_ = 33,                       /* ';'  */
+  YYSYMBOL_34_ = 34,                       /* '{'  */
+  YYSYMBOL_35_ = 35,                       /* '}'  */
+  YYSYMBOL_36_ = 36,                       /* '['  */
+  YYSYMBOL_37_ = 37,                       /* ']'  */
+  YYSYMBOL_dangling_else = 38,             /* dangling_else  */
+  YYSYMBOL_YYACCEPT = 39,                  /* $accept  */
+  YYSYMBOL_prog = 40,                      /* prog  */
+  YYSYMBOL_41_1 = 41,                      /* $@1  */
+  YYSYMBOL_Extern = 42,                    /* Extern  */
+  YYSYMBOL_SetFnInfo = 43,                 /* SetFnInfo  */
+  YYSYMBOL_fprotRest = 44,                 /* fprotRest  */
+  YYSYMBOL_45_2 = 45,                      /* $@2  */
+  YYSYMBOL_fprototype = 46,                /* fprototype  */
+  YYSYMBOL_parm_types = 47,                /* parm_types  */
+  YYSYMBOL_nonempty_parm_type_list = 48,   /* nonempty_parm_type_list  */
+  YYSYMBOL_parm_type_decl = 49,            /* parm_type_decl  */
+  YYSYMBOL_type = 50,                      /* type  */
+  YYSYMBOL_var_decls = 51,                 /* var_decls  */
+  YYSYMBOL_var_decl = 52,                  /* var_decl  */
+  YYSYMBOL_id_list = 53,                   /* id_list  */
+  YYSYMBOL_54_3 = 54,                      /* $@3  */
+  YYSYMBOL_55_4 = 55,                      /* $@4  */
+  YYSYMBOL_id_decl = 56,                   /* id_decl  */
+  YYSYMBOL_ArraySize = 57,                 /* ArraySize  */
+  YYSYMBOL_stmt_list = 58,                 /* stmt_list  */
+  YYSYMBOL_stmts = 59,                     /* stmts  */
+  YYSYMBOL_stmt = 60,                      /* stmt  */
+  YYSYMBOL_61_5 = 61,                      /* $@5  */
+  YYSYMBOL_semicolon = 62,                 /* semicolon  */
+  YYSYMBOL_63_6 = 63,                      /* $@6  */
+  YYSYMBOL_comma = 64,                     /* comma  */
+  YYSYMBOL_65_7 = 65,                      /* $@7  */
+  YYSYMBOL_compound_stmt = 66,             /* compound_stmt  */
+  YYSYMBOL_block_start = 67,               /* block_start  */
+  YYSYMBOL_optional_else = 68,             /* optional_else  */
+  YYSYMBOL_optional_assgt = 69,            /* optional_assgt  */
+  YYSYMBOL_optional_expr = 70,             /* optional_expr  */
+  YYSYMBOL_optional_boolexp = 71,          /* optional_boolexp  */
+  YYSYMBOL_assignment = 72,                /* assignment  */
+  YYSYMBOL_boolexp = 73,                   /* boolexp  */
+  YYSYMBOL_expr = 74,                      /* expr  */
+  YYSYMBOL_fun_call = 75,                  /* fun_call  */
+  YYSYMBOL_proc_call = 76,                 /* proc_call  */
+  YYSYMBOL_variable = 77,                  /* variable  */
+  YYSYMBOL_expr_list = 78,                 /* expr_list  */
+  YYSYMBOL_Ident = 79                      /* Ident  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
 
 
-/* Line 216 of yacc.c.  */
-#line 207 "y.tab.c"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
 typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef short int yytype_int8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -241,55 +413,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int i)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (i)
-    int i;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return i;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -306,11 +529,11 @@ YYID (i)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -318,8 +541,8 @@ YYID (i)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -333,111 +556,117 @@ YYID (i)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss;
-  YYSTYPE yyvs;
-  };
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack)					\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack, Stack, yysize);				\
-	Stack = &yyptr->Stack;						\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  2
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   294
+#define YYLAST   298
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  39
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  38
+#define YYNNTS  41
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  94
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  181
+#define YYNRULES  98
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  185
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   277
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -445,7 +674,7 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,    25,     2,     2,     2,     2,     2,     2,
       31,    32,    28,    26,    30,    27,     2,    29,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,    33,
-      21,    24,    23,     2,     2,     2,     2,     2,     2,     2,
+      22,    24,    23,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,    36,     2,    37,     2,     2,     2,     2,     2,     2,
@@ -466,397 +695,301 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
-      15,    16,    17,    18,    19,    20,    22,    38
+      15,    16,    17,    18,    19,    20,    21,    38
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint16 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     8,    17,    27,    28,    41,    42,    44,
-      45,    46,    52,    54,    59,    61,    63,    67,    69,    72,
-      77,    79,    81,    83,    87,    88,    91,    92,    97,    98,
-     103,   105,   107,   112,   114,   117,   118,   125,   131,   141,
-     145,   148,   151,   153,   155,   157,   159,   160,   163,   165,
-     166,   169,   173,   176,   177,   179,   180,   182,   183,   185,
-     186,   190,   194,   198,   202,   206,   210,   214,   217,   221,
-     225,   229,   232,   236,   240,   244,   248,   250,   252,   256,
-     260,   262,   264,   266,   270,   275,   280,   284,   289,   294,
-     296,   301,   306,   310,   312
+       0,   123,   123,   125,   127,   130,   129,   146,   149,   151,
+     160,   160,   161,   165,   177,   178,   186,   187,   191,   192,
+     197,   198,   199,   203,   204,   208,   212,   212,   213,   213,
+     214,   218,   229,   243,   254,   255,   259,   260,   264,   270,
+     277,   276,   284,   308,   309,   310,   311,   312,   320,   321,
+     321,   325,   326,   326,   341,   348,   352,   353,   357,   358,
+     362,   363,   367,   368,   372,   394,   395,   396,   397,   398,
+     399,   400,   401,   402,   403,   407,   408,   409,   410,   411,
+     412,   413,   414,   415,   416,   417,   418,   422,   446,   468,
+     479,   505,   531,   542,   552,   579,   594,   595,   598
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      40,     0,    -1,    40,    50,    53,    33,    -1,    40,    50,
-      76,    31,    43,    47,    32,    44,    -1,    40,    42,    50,
-      76,    31,    43,    47,    32,    44,    -1,    -1,    40,    50,
-      76,    31,    43,    47,    32,    34,    41,    51,    58,    35,
-      -1,    -1,    10,    -1,    -1,    -1,    62,    45,    46,    43,
-      44,    -1,    33,    -1,    76,    31,    47,    32,    -1,     9,
-      -1,    48,    -1,    48,    62,    49,    -1,    49,    -1,    50,
-      76,    -1,    50,    76,    36,    37,    -1,     8,    -1,     7,
-      -1,     9,    -1,    51,    52,    33,    -1,    -1,    50,    53,
-      -1,    -1,    53,    62,    54,    56,    -1,    -1,     1,    62,
-      55,    56,    -1,    56,    -1,    76,    -1,    76,    36,    57,
-      37,    -1,     4,    -1,    59,    58,    -1,    -1,    11,    31,
-      70,    32,    59,    65,    -1,    13,    31,    70,    32,    59,
-      -1,    14,    31,    66,    60,    68,    60,    66,    32,    59,
-      -1,    15,    67,    60,    -1,    69,    60,    -1,    73,    60,
-      -1,    64,    -1,    33,    -1,     1,    -1,    33,    -1,    -1,
-      61,     1,    -1,    30,    -1,    -1,    63,     1,    -1,    34,
-      58,    35,    -1,    12,    59,    -1,    -1,    69,    -1,    -1,
-      71,    -1,    -1,    70,    -1,    -1,    74,    24,    71,    -1,
-      71,    18,    71,    -1,    71,    19,    71,    -1,    71,    20,
-      71,    -1,    71,    22,    71,    -1,    71,    21,    71,    -1,
-      71,    23,    71,    -1,    25,    70,    -1,    70,    16,    70,
-      -1,    70,    17,    70,    -1,    31,    70,    32,    -1,    27,
-      71,    -1,    71,    26,    71,    -1,    71,    27,    71,    -1,
-      71,    28,    71,    -1,    71,    29,    71,    -1,    72,    -1,
-      74,    -1,    31,    71,    32,    -1,    31,     1,    32,    -1,
-       4,    -1,     5,    -1,     6,    -1,    76,    31,    32,    -1,
-      76,    31,    75,    32,    -1,    76,    31,     1,    32,    -1,
-      76,    31,    32,    -1,    76,    31,    75,    32,    -1,    76,
-      31,     1,    32,    -1,    76,    -1,    76,    36,    71,    37,
-      -1,    76,    36,     1,    37,    -1,    71,    62,    75,    -1,
-      71,    -1,     3,    -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,    94,    94,    96,    98,   101,   100,   114,   117,   119,
-     128,   128,   129,   133,   145,   146,   150,   151,   155,   156,
-     161,   162,   163,   167,   168,   172,   176,   176,   177,   177,
-     178,   182,   193,   207,   211,   212,   216,   222,   228,   234,
-     258,   259,   260,   261,   262,   270,   271,   271,   275,   276,
-     276,   280,   284,   285,   289,   290,   294,   295,   299,   300,
-     304,   326,   327,   328,   329,   330,   331,   332,   333,   334,
-     335,   339,   340,   341,   342,   343,   344,   345,   346,   347,
-     348,   349,   350,   355,   379,   401,   412,   438,   464,   475,
-     485,   512,   527,   528,   531
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "ID", "INTCON", "CHARCON", "STRINGCON",
-  "CHAR", "INT", "VOID", "EXTERN", "IF", "ELSE", "WHILE", "FOR", "RETURN",
-  "AND", "OR", "EQ", "NEQ", "LE", "'<'", "GE", "'>'", "'='", "'!'", "'+'",
-  "'-'", "'*'", "'/'", "','", "'('", "')'", "';'", "'{'", "'}'", "'['",
-  "']'", "dangling_else", "$accept", "prog", "@1", "Extern", "SetFnInfo",
-  "fprotRest", "@2", "fprototype", "parm_types", "nonempty_parm_type_list",
-  "parm_type_decl", "type", "var_decls", "var_decl", "id_list", "@3", "@4",
-  "id_decl", "ArraySize", "stmt_list", "stmt", "semicolon", "@5", "comma",
-  "@6", "compound_stmt", "optional_else", "optional_assgt",
+  "\"end of file\"", "error", "\"invalid token\"", "ID", "INTCON",
+  "CHARCON", "STRINGCON", "CHAR", "INT", "VOID", "EXTERN", "IF", "ELSE",
+  "WHILE", "FOR", "RETURN", "AND", "OR", "EQ", "NEQ", "LE", "GE", "'<'",
+  "'>'", "'='", "'!'", "'+'", "'-'", "'*'", "'/'", "','", "'('", "')'",
+  "';'", "'{'", "'}'", "'['", "']'", "dangling_else", "$accept", "prog",
+  "$@1", "Extern", "SetFnInfo", "fprotRest", "$@2", "fprototype",
+  "parm_types", "nonempty_parm_type_list", "parm_type_decl", "type",
+  "var_decls", "var_decl", "id_list", "$@3", "$@4", "id_decl", "ArraySize",
+  "stmt_list", "stmts", "stmt", "$@5", "semicolon", "$@6", "comma", "$@7",
+  "compound_stmt", "block_start", "optional_else", "optional_assgt",
   "optional_expr", "optional_boolexp", "assignment", "boolexp", "expr",
-  "fun_call", "proc_call", "variable", "expr_list", "Ident", 0
+  "fun_call", "proc_call", "variable", "expr_list", "Ident", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,    60,   276,    62,    61,    33,    43,    45,    42,    47,
-      44,    40,    41,    59,   123,   125,    91,    93,   277
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    39,    40,    40,    40,    41,    40,    40,    42,    43,
-      45,    44,    44,    46,    47,    47,    48,    48,    49,    49,
-      50,    50,    50,    51,    51,    52,    54,    53,    55,    53,
-      53,    56,    56,    57,    58,    58,    59,    59,    59,    59,
-      59,    59,    59,    59,    59,    60,    61,    60,    62,    63,
-      62,    64,    65,    65,    66,    66,    67,    67,    68,    68,
-      69,    70,    70,    70,    70,    70,    70,    70,    70,    70,
-      70,    71,    71,    71,    71,    71,    71,    71,    71,    71,
-      71,    71,    71,    72,    72,    72,    73,    73,    73,    74,
-      74,    74,    75,    75,    76
-};
+#define YYPACT_NINF (-77)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-53)
+
+#define yytable_value_is_error(Yyn) \
+  0
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
 {
-       0,     2,     4,     8,     9,     0,    12,     0,     1,     0,
-       0,     5,     1,     4,     1,     1,     3,     1,     2,     4,
-       1,     1,     1,     3,     0,     2,     0,     4,     0,     4,
-       1,     1,     4,     1,     2,     0,     6,     5,     9,     3,
-       2,     2,     1,     1,     1,     1,     0,     2,     1,     0,
-       2,     3,     2,     0,     1,     0,     1,     0,     1,     0,
-       3,     3,     3,     3,     3,     3,     3,     2,     3,     3,
-       3,     2,     3,     3,     3,     3,     1,     1,     3,     3,
-       1,     1,     1,     3,     4,     4,     3,     4,     4,     1,
-       4,     4,     3,     1,     1
+     -77,   281,   -77,   -77,   -77,   -77,   -77,    89,    22,    11,
+       3,   -77,    33,   -77,   -16,    31,   -77,   -77,    36,   -77,
+     -77,   -77,    77,   -77,    11,   -77,    11,   142,   -77,    18,
+     142,   -77,    87,   -77,   119,    95,    20,   -77,    11,   -77,
+      99,    73,    89,    97,    86,   -77,   -77,   -77,   -77,   -77,
+      98,   -77,   -77,    11,   -77,   145,   -77,   124,   -77,   126,
+     130,   137,   232,   -77,   -77,    22,   138,   135,    79,   -77,
+     -77,   -77,   139,   139,   150,   -14,    86,   142,   227,   227,
+      11,   -77,   -77,   -77,   232,   192,   139,   111,   -77,   -77,
+      -4,    20,   -77,   -77,   -77,   145,   -77,   -77,   175,   -77,
+     232,   180,   198,   -77,   156,   227,    48,    51,   246,    53,
+     139,   -77,   141,   -77,   162,   266,   -77,   232,   232,   232,
+     232,   186,   165,   -77,   111,   173,   -77,   111,    59,   169,
+     250,   -77,   -77,    83,   221,   227,   227,    25,   232,   232,
+     232,   232,   232,   232,    25,   227,   -77,   -77,    13,    13,
+     -77,   -77,   176,   -77,    72,   -77,   -77,   -77,   232,   -77,
+     -77,   -77,   -77,   -77,   197,   111,   111,   111,   111,   111,
+     111,   -77,   139,    60,   -77,   -77,   111,    25,   -77,   -77,
+     -77,    11,   178,    25,   -77
 };
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
    means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+static const yytype_int8 yydefact[] =
 {
        7,     0,     1,    21,    20,    22,     8,     0,     0,     0,
-      49,    94,    49,    30,    31,     0,    48,    28,     0,     2,
-      26,     9,     0,     9,     0,    50,     0,     0,    33,     0,
+      52,    98,    52,    30,    31,     0,    51,    28,     0,     2,
+      26,     9,     0,     9,     0,    53,     0,     0,    33,     0,
        0,    29,    31,    27,    14,     0,    15,    17,     0,    32,
-       0,    49,     0,    18,    49,    12,     5,     3,    10,    16,
-       0,     4,    24,     0,    19,     0,     9,     0,    44,     0,
-       0,     0,    57,    43,     0,     0,     0,     0,     0,    42,
-      46,    46,     0,    89,    49,     0,     0,     0,    55,    80,
-      81,    82,     0,     0,    46,    56,    76,    77,    89,     0,
-      25,    23,     6,    34,    45,    40,     0,    41,     0,     0,
-       0,    11,     0,     0,     0,     0,     0,     0,    46,    54,
-      89,    71,     0,     0,    39,     0,     0,     0,     0,     0,
-      51,    47,    60,     0,    86,    49,     0,     0,     0,    13,
-      67,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,    59,    79,    78,    72,    73,    74,    75,
-       0,    83,     0,    88,     0,    87,    91,    90,    70,    68,
-      69,    53,    61,    62,    63,    65,    64,    66,    37,    46,
-      58,    85,    84,    92,     0,    36,    55,    52,     0,     0,
-      38
+       0,    52,     0,    18,    52,    12,     5,     3,    10,    16,
+       0,     4,    24,     0,    19,     0,     9,     0,    47,     0,
+       0,     0,    61,    46,    55,     0,     0,     0,     0,    37,
+      45,    24,    49,    49,     0,    93,    52,     0,     0,     0,
+      59,    84,    85,    86,     0,     0,    49,    60,    80,    81,
+      93,    25,    23,     6,    36,     0,    48,    43,     0,    44,
+       0,     0,     0,    11,     0,     0,     0,     0,     0,     0,
+      49,    58,    93,    75,     0,     0,    42,     0,     0,     0,
+       0,     0,     0,    50,    64,     0,    90,    97,    52,     0,
+       0,    13,    71,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    63,    83,    82,    76,    77,
+      78,    79,     0,    87,    52,    54,    92,    91,     0,    95,
+      94,    74,    72,    73,    57,    65,    66,    67,    68,    69,
+      70,    39,    49,    62,    89,    88,    96,     0,    38,    40,
+      56,    59,     0,     0,    41
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+     -77,   -77,   -77,   -77,   -13,   -32,   -77,   -77,   -21,   -77,
+     172,     6,   144,   -77,   151,   -77,   -77,    94,   -77,   125,
+     -77,   -66,   -77,   -62,   -77,    -7,   -77,   -77,   -77,   -77,
+      40,   -77,   -77,   -76,   -71,    24,   -77,   -77,   -49,   101,
+      -8
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,     1,    52,     7,    27,    47,    53,    56,    35,    36,
+       0,     1,    52,     7,    27,    47,    53,    56,    35,    36,
       37,    38,    55,    66,    12,    26,    24,    13,    29,    67,
-      68,    95,    96,    48,    18,    69,   175,   108,    84,   169,
-      70,   105,   106,    86,    71,    87,   126,    88
+      68,    69,   181,    97,    98,    48,    18,    70,    71,   178,
+     110,    86,   172,    72,   107,   108,    88,    73,    89,   128,
+      90
 };
 
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -108
-static const yytype_int16 yypact[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
-    -108,   266,  -108,  -108,  -108,  -108,  -108,   200,   137,    24,
-      16,  -108,    57,  -108,     0,    22,  -108,  -108,    70,  -108,
-    -108,  -108,    84,  -108,    24,  -108,    24,   208,  -108,    63,
-     208,  -108,    96,  -108,   102,   101,    25,  -108,    24,  -108,
-     117,    73,   200,   119,    92,  -108,  -108,  -108,  -108,  -108,
-      91,  -108,  -108,    24,  -108,   128,  -108,   129,  -108,   133,
-     134,   136,    93,  -108,     9,   137,   126,   135,     9,  -108,
-     139,   139,   145,     1,    92,   208,   228,   228,    24,  -108,
-    -108,  -108,    93,   193,   139,   265,  -108,  -108,    30,   138,
-      25,  -108,  -108,  -108,  -108,  -108,   174,  -108,    93,   147,
-     199,  -108,   149,   228,   187,    33,   242,    52,   139,  -108,
-     150,  -108,   155,   258,  -108,    93,    93,    93,    93,   179,
-    -108,  -108,   265,   157,  -108,   251,   163,   164,    82,  -108,
-    -108,    69,   217,   228,   228,   143,    93,    93,    93,    93,
-      93,    93,   143,   228,  -108,  -108,    11,    11,  -108,  -108,
-     181,  -108,   189,  -108,    93,  -108,  -108,  -108,  -108,  -108,
-    -108,   207,   265,   265,   265,   265,   265,   265,  -108,   139,
-      62,  -108,  -108,  -108,   143,  -108,    24,  -108,   190,   143,
-    -108
+      14,    15,    94,    17,   111,    20,    74,     8,   109,    40,
+      30,    99,    51,     9,    11,    21,    32,   101,    32,    74,
+      22,   -52,   102,    10,   116,    11,    58,   121,    11,    42,
+      43,    74,   102,    16,   132,   133,    59,    25,    60,    61,
+      62,   119,   120,    76,   103,    57,    74,    75,   145,   114,
+      16,    11,    81,    82,    83,    39,   104,    32,    63,    64,
+      75,    65,    23,    16,   162,   163,    19,   135,   136,   135,
+     136,   164,   112,   105,   173,    84,   135,   136,   171,   106,
+      58,    28,    11,   137,    20,   144,    87,    75,    74,    16,
+      59,   157,    60,    61,    62,    74,     3,     4,     5,   135,
+     136,    65,    16,    16,   175,   111,    45,    46,   113,   115,
+     179,   180,    63,    64,   -34,   161,    16,   184,    31,    45,
+      33,   158,   -22,    22,   124,   127,   130,    41,    74,    75,
+     134,    44,    74,    50,    74,    54,    75,   117,   118,   119,
+     120,   148,   149,   150,   151,   127,    58,   158,    11,     3,
+       4,    34,     3,     4,     5,    77,    59,    78,    60,    61,
+      62,    79,   165,   166,   167,   168,   169,   170,    80,    75,
+      93,    92,    96,   112,   100,    75,   123,   102,    63,    64,
+     -35,   125,   176,    11,    81,    82,    83,   152,   131,    11,
+      81,    82,    83,   114,   146,    11,    81,    82,    83,   129,
+     155,    11,    81,    82,    83,   156,   159,    84,   174,   177,
+     183,    85,   126,    84,    49,    95,    91,    85,   153,    84,
+     122,   182,   154,    85,     0,    84,     0,     0,     0,    85,
+      11,    81,    82,    83,     0,    11,    81,    82,    83,   138,
+     139,   140,   141,   142,   143,     0,     0,   117,   118,   119,
+     120,     0,   105,   147,    84,     0,     0,     0,   106,    84,
+       0,     0,     0,    85,   138,   139,   140,   141,   142,   143,
+       0,     0,   117,   118,   119,   120,   117,   118,   119,   120,
+       0,     2,     0,     0,     0,     0,     0,   160,     3,     4,
+       5,     6,   117,   118,   119,   120,     0,     0,   147
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int16 yypgoto[] =
+static const yytype_int16 yycheck[] =
 {
-    -108,  -108,  -108,  -108,    -4,   -23,  -108,  -108,   -21,  -108,
-     183,     7,  -108,  -108,   158,  -108,  -108,   121,  -108,    13,
-    -107,   -67,  -108,    -7,  -108,  -108,  -108,    51,  -108,  -108,
-     -72,   -70,   -24,  -108,  -108,   -53,  -106,    -8
+       8,     9,    68,    10,    80,    12,    55,     1,    79,    30,
+      23,    73,    44,     7,     3,    31,    24,    31,    26,    68,
+      36,     1,    36,     1,    86,     3,     1,    31,     3,    36,
+      38,    80,    36,    30,   105,   106,    11,     1,    13,    14,
+      15,    28,    29,    56,    76,    53,    95,    55,   110,     1,
+      30,     3,     4,     5,     6,    37,    77,    65,    33,    34,
+      68,    55,    31,    30,   135,   136,    33,    16,    17,    16,
+      17,   137,    80,    25,   145,    27,    16,    17,   144,    31,
+       1,     4,     3,    32,    91,    32,    62,    95,   137,    30,
+      11,    32,    13,    14,    15,   144,     7,     8,     9,    16,
+      17,    95,    30,    30,    32,   181,    33,    34,    84,    85,
+     172,   177,    33,    34,    35,    32,    30,   183,    24,    33,
+      26,   128,     3,    36,   100,   101,   102,    32,   177,   137,
+     106,    32,   181,    36,   183,    37,   144,    26,    27,    28,
+      29,   117,   118,   119,   120,   121,     1,   154,     3,     7,
+       8,     9,     7,     8,     9,    31,    11,    31,    13,    14,
+      15,    31,   138,   139,   140,   141,   142,   143,    31,   177,
+      35,    33,    33,   181,    24,   183,     1,    36,    33,    34,
+      35,     1,   158,     3,     4,     5,     6,     1,    32,     3,
+       4,     5,     6,     1,    32,     3,     4,     5,     6,     1,
+      35,     3,     4,     5,     6,    32,    37,    27,    32,    12,
+      32,    31,    32,    27,    42,    71,    65,    31,    32,    27,
+      95,   181,   121,    31,    -1,    27,    -1,    -1,    -1,    31,
+       3,     4,     5,     6,    -1,     3,     4,     5,     6,    18,
+      19,    20,    21,    22,    23,    -1,    -1,    26,    27,    28,
+      29,    -1,    25,    32,    27,    -1,    -1,    -1,    31,    27,
+      -1,    -1,    -1,    31,    18,    19,    20,    21,    22,    23,
+      -1,    -1,    26,    27,    28,    29,    26,    27,    28,    29,
+      -1,     0,    -1,    -1,    -1,    -1,    -1,    37,     7,     8,
+       9,    10,    26,    27,    28,    29,    -1,    -1,    32
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -94
-static const yytype_int16 yytable[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-      14,    15,    72,    17,    97,    20,   109,   107,     8,    40,
-      58,    72,    11,   152,     9,    72,    32,   114,    32,    30,
-      59,    51,    60,    61,    62,    72,   -49,    11,   161,    42,
-      43,    21,    99,   130,   131,   168,    22,   100,    85,   117,
-     118,   143,    63,    64,   -35,    57,    16,    73,   173,   133,
-     134,   101,    74,    23,   102,    16,    73,    32,   111,   113,
-      73,   119,    65,   159,   160,   135,   100,   177,   133,   134,
-     110,    25,   180,   170,   122,   125,   128,    89,   133,   134,
-     132,    93,    72,    20,   142,   133,   134,    16,    28,    72,
-      19,   146,   147,   148,   149,   125,    11,    79,    80,    81,
-      39,   158,   176,    16,   109,   -22,    45,    46,   115,   116,
-     117,   118,   162,   163,   164,   165,   166,   167,   154,   157,
-      82,    72,    16,    72,    83,    45,    72,    73,    54,    58,
-     125,    11,    22,    41,    73,     3,     4,     5,    10,    59,
-      11,    60,    61,    62,    58,    31,    11,    33,   123,    44,
-      11,    79,    80,    81,    59,    50,    60,    61,    62,    91,
-      75,    63,    64,   -35,    76,    77,    73,    78,   110,    98,
-      92,    73,    94,   120,    82,   121,    63,    64,    83,   124,
-     150,   129,    11,    79,    80,    81,   100,   144,   112,   153,
-      11,    79,    80,    81,   112,   155,    11,    79,    80,    81,
-     127,   156,    11,    79,    80,    81,    82,     3,     4,     5,
-      83,   151,   103,   171,    82,     3,     4,    34,   104,   174,
-      82,   172,   179,    90,    83,    49,    82,   178,     0,     0,
-      83,    11,    79,    80,    81,   136,   137,   138,   139,   140,
-     141,     0,     0,   115,   116,   117,   118,     0,     0,   145,
-       0,     0,     0,   103,     0,    82,     0,     0,     0,   104,
-     136,   137,   138,   139,   140,   141,     2,     0,   115,   116,
-     117,   118,     0,     3,     4,     5,     6,   115,   116,   117,
-     118,    16,     0,   -93,   115,   116,   117,   118,     0,     0,
-     145,   115,   116,   117,   118
+       0,    40,     0,     7,     8,     9,    10,    42,    50,    50,
+       1,     3,    53,    56,    79,    79,    30,    64,    65,    33,
+      64,    31,    36,    31,    55,     1,    54,    43,     4,    57,
+      43,    56,    79,    56,     9,    47,    48,    49,    50,    37,
+      47,    32,    64,    79,    32,    33,    34,    44,    64,    49,
+      36,    44,    41,    45,    37,    51,    46,    79,     1,    11,
+      13,    14,    15,    33,    34,    50,    52,    58,    59,    60,
+      66,    67,    72,    76,    77,    79,    43,    31,    31,    31,
+      31,     4,     5,     6,    27,    31,    70,    74,    75,    77,
+      79,    53,    33,    35,    60,    51,    33,    62,    63,    62,
+      24,    31,    36,    44,    47,    25,    31,    73,    74,    73,
+      69,    72,    79,    74,     1,    74,    62,    26,    27,    28,
+      29,    31,    58,     1,    74,     1,    32,    74,    78,     1,
+      74,    32,    73,    73,    74,    16,    17,    32,    18,    19,
+      20,    21,    22,    23,    32,    62,    32,    32,    74,    74,
+      74,    74,     1,    32,    78,    35,    32,    32,    64,    37,
+      37,    32,    73,    73,    60,    74,    74,    74,    74,    74,
+      74,    60,    71,    73,    32,    32,    74,    12,    68,    62,
+      60,    61,    69,    32,    60
 };
 
-static const yytype_int16 yycheck[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       8,     9,    55,    10,    71,    12,    78,    77,     1,    30,
-       1,    64,     3,   119,     7,    68,    24,    84,    26,    23,
-      11,    44,    13,    14,    15,    78,     1,     3,   135,    36,
-      38,    31,    31,   103,   104,   142,    36,    36,    62,    28,
-      29,   108,    33,    34,    35,    53,    30,    55,   154,    16,
-      17,    74,    56,    31,    75,    30,    64,    65,    82,    83,
-      68,    31,    55,   133,   134,    32,    36,   174,    16,    17,
-      78,     1,   179,   143,    98,    99,   100,    64,    16,    17,
-     104,    68,   135,    90,    32,    16,    17,    30,     4,   142,
-      33,   115,   116,   117,   118,   119,     3,     4,     5,     6,
-      37,    32,   169,    30,   176,     3,    33,    34,    26,    27,
-      28,    29,   136,   137,   138,   139,   140,   141,   125,    37,
-      27,   174,    30,   176,    31,    33,   179,   135,    37,     1,
-     154,     3,    36,    32,   142,     7,     8,     9,     1,    11,
-       3,    13,    14,    15,     1,    24,     3,    26,     1,    32,
-       3,     4,     5,     6,    11,    36,    13,    14,    15,    33,
-      31,    33,    34,    35,    31,    31,   174,    31,   176,    24,
-      35,   179,    33,    35,    27,     1,    33,    34,    31,    32,
-       1,    32,     3,     4,     5,     6,    36,    32,     1,    32,
-       3,     4,     5,     6,     1,    32,     3,     4,     5,     6,
-       1,    37,     3,     4,     5,     6,    27,     7,     8,     9,
-      31,    32,    25,    32,    27,     7,     8,     9,    31,    12,
-      27,    32,    32,    65,    31,    42,    27,   176,    -1,    -1,
-      31,     3,     4,     5,     6,    18,    19,    20,    21,    22,
-      23,    -1,    -1,    26,    27,    28,    29,    -1,    -1,    32,
-      -1,    -1,    -1,    25,    -1,    27,    -1,    -1,    -1,    31,
-      18,    19,    20,    21,    22,    23,     0,    -1,    26,    27,
-      28,    29,    -1,     7,     8,     9,    10,    26,    27,    28,
-      29,    30,    -1,    32,    26,    27,    28,    29,    -1,    -1,
-      32,    26,    27,    28,    29
+       0,    39,    40,    40,    40,    41,    40,    40,    42,    43,
+      45,    44,    44,    46,    47,    47,    48,    48,    49,    49,
+      50,    50,    50,    51,    51,    52,    54,    53,    55,    53,
+      53,    56,    56,    57,    58,    58,    59,    59,    60,    60,
+      61,    60,    60,    60,    60,    60,    60,    60,    62,    63,
+      62,    64,    65,    64,    66,    67,    68,    68,    69,    69,
+      70,    70,    71,    71,    72,    73,    73,    73,    73,    73,
+      73,    73,    73,    73,    73,    74,    74,    74,    74,    74,
+      74,    74,    74,    74,    74,    74,    74,    75,    75,    75,
+      76,    76,    76,    77,    77,    77,    78,    78,    79
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
-       0,    40,     0,     7,     8,     9,    10,    42,    50,    50,
-       1,     3,    53,    56,    76,    76,    30,    62,    63,    33,
-      62,    31,    36,    31,    55,     1,    54,    43,     4,    57,
-      43,    56,    76,    56,     9,    47,    48,    49,    50,    37,
-      47,    32,    62,    76,    32,    33,    34,    44,    62,    49,
-      36,    44,    41,    45,    37,    51,    46,    76,     1,    11,
-      13,    14,    15,    33,    34,    50,    52,    58,    59,    64,
-      69,    73,    74,    76,    43,    31,    31,    31,    31,     4,
-       5,     6,    27,    31,    67,    71,    72,    74,    76,    58,
-      53,    33,    35,    58,    33,    60,    61,    60,    24,    31,
-      36,    44,    47,    25,    31,    70,    71,    70,    66,    69,
-      76,    71,     1,    71,    60,    26,    27,    28,    29,    31,
-      35,     1,    71,     1,    32,    71,    75,     1,    71,    32,
-      70,    70,    71,    16,    17,    32,    18,    19,    20,    21,
-      22,    23,    32,    60,    32,    32,    71,    71,    71,    71,
-       1,    32,    75,    32,    62,    32,    37,    37,    32,    70,
-      70,    59,    71,    71,    71,    71,    71,    71,    59,    68,
-      70,    32,    32,    75,    12,    65,    60,    59,    66,    32,
-      59
+       0,     2,     4,     8,     9,     0,    12,     0,     1,     0,
+       0,     5,     1,     4,     1,     1,     3,     1,     2,     4,
+       1,     1,     1,     3,     0,     2,     0,     4,     0,     4,
+       1,     1,     4,     1,     1,     0,     2,     1,     6,     5,
+       0,    10,     3,     2,     2,     1,     1,     1,     1,     0,
+       2,     1,     0,     2,     4,     1,     2,     0,     1,     0,
+       1,     0,     1,     0,     3,     3,     3,     3,     3,     3,
+       3,     2,     3,     3,     3,     2,     3,     3,     3,     3,
+       1,     1,     3,     3,     1,     1,     1,     3,     4,     4,
+       3,     4,     4,     1,     4,     4,     3,     1,     1
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
 
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#define YYFAIL		goto yyerrlab
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
-
-
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
-
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
-
-
-/* YYLEX -- calling `yylex' with the right arguments.  */
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -866,80 +999,58 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -947,80 +1058,68 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *bottom, yytype_int16 *top)
-#else
 static void
-yy_stack_print (bottom, top)
-    yytype_int16 *bottom;
-    yytype_int16 *top;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
-  for (; bottom <= top; ++bottom)
-    YYFPRINTF (stderr, " %d", *bottom);
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
-static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
-      fprintf (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
-      fprintf (stderr, "\n");
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1035,277 +1134,41 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
 
-#if YYERROR_VERBOSE
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
-
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  switch (yytype)
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  switch (yykind)
     {
+    case YYSYMBOL_block_start: /* block_start  */
+#line 111 "parser.y"
+            { SymTabExitScope(((*yyvaluep).nval)); }
+#line 1162 "y.tab.c"
+        break;
 
       default:
-	break;
+        break;
     }
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
-
-
-/* Prevent warnings from -Wmissing-prototypes.  */
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
-
-
-/* The look-ahead symbol.  */
-int yychar;
 
-/* The semantic value of the look-ahead symbol.  */
-YYSTYPE yylval;
 
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 
@@ -1313,200 +1176,193 @@ int yynerrs;
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
-  
-  int yystate;
-  int yyn;
-  int yyresult;
-  /* Number of tokens to shift before error messages enabled.  */
-  int yyerrstatus;
-  /* Look-ahead token as an internal (translated) token number.  */
-  int yytoken = 0;
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+/* Lookahead token kind.  */
+int yychar;
 
-  /* Three stacks and their tools:
-     `yyss': related to states,
-     `yyvs': related to semantic values,
-     `yyls': related to locations.
 
-     Refer to the stacks thru separate pointers, to allow yyoverflow
-     to reallocate them elsewhere.  */
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
-  /* The state stack.  */
-  yytype_int16 yyssa[YYINITDEPTH];
-  yytype_int16 *yyss = yyssa;
-  yytype_int16 *yyssp;
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-  /* The semantic value stack.  */
-  YYSTYPE yyvsa[YYINITDEPTH];
-  YYSTYPE *yyvs = yyvsa;
-  YYSTYPE *yyvsp;
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-  YYSIZE_T yystacksize = YYINITDEPTH;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
 
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
   /* The number of symbols on the RHS of the reduced rule.
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY;		/* Cause a token to be read.  */
-
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-
-  yyssp = yyss;
-  yyvsp = yyvs;
+  yychar = YYEMPTY; /* Cause a token to be read.  */
 
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss);
-	YYSTACK_RELOCATE (yyvs);
-
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
-     look-ahead token if we need one and don't already have one.  */
+     lookahead token if we need one and don't already have one.  */
 
-  /* First try to decide what to do without reference to look-ahead token.  */
+  /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
-  /* Not known => get a look-ahead token if don't already have one.  */
+  /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid look-ahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1521,30 +1377,26 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
   /* Count tokens shifted since error; after three, turn off error
      status.  */
   if (yyerrstatus)
     yyerrstatus--;
 
-  /* Shift the look-ahead token.  */
+  /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token unless it is eof.  */
-  if (yychar != YYEOF)
-    yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1559,14 +1411,15 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
+  CountEvent(CNT_REDUCTIONS, 1);
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1579,122 +1432,143 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 5:
-#line 101 "parser.y"
+  case 5: /* $@1: %empty  */
+#line 130 "parser.y"
     { currFun = SymTabRecordFunInfo(false);}
+#line 1438 "y.tab.c"
     break;
 
-  case 6:
-#line 103 "parser.y"
+  case 6: /* prog: prog type Ident '(' SetFnInfo parm_types ')' '{' $@1 var_decls stmt_list '}'  */
+#line 132 "parser.y"
     { 
-      currfnbodyTree = AppendReturn((yyvsp[(11) - (12)].tptr));
+      currfnbodyTree = AppendReturn((yyvsp[-1].tseq));
       /*
        * At this point, currfnbodyTree points to the syntax tree
        * for the body of the current function.  This can then
        * be traversed for code generation etc.
        */
-      process_syntax_tree(currFun, currfnbodyTree);
+      CountEvent(CNT_FUNCS, 1);
+      PhaseBegin(PH_PROCESS);
+      BackendSubmit(currFun, currfnbodyTree);
+      PhaseEnd();
 
       CleanupFnInfo(); 
     }
+#line 1457 "y.tab.c"
     break;
 
-  case 8:
-#line 117 "parser.y"
-    { is_extern = true; }
+  case 8: /* Extern: EXTERN  */
+#line 149 "parser.y"
+                { is_extern = true; }
+#line 1463 "y.tab.c"
     break;
 
-  case 9:
-#line 119 "parser.y"
-    { 
+  case 9: /* SetFnInfo: %empty  */
+#line 151 "parser.y"
+            { 
 	CurrScope = Local; 
 	fnRetType = CurrType;
 	fnName = id_name;
 	lptr = NULL;
   }
+#line 1474 "y.tab.c"
     break;
 
-  case 10:
-#line 128 "parser.y"
-    { SymTabRecordFunInfo(true); }
+  case 10: /* $@2: %empty  */
+#line 160 "parser.y"
+          { SymTabRecordFunInfo(true); }
+#line 1480 "y.tab.c"
     break;
 
-  case 12:
-#line 129 "parser.y"
-    { SymTabRecordFunInfo(true); CleanupFnInfo(); }
+  case 12: /* fprotRest: ';'  */
+#line 161 "parser.y"
+        { SymTabRecordFunInfo(true); CleanupFnInfo(); }
+#line 1486 "y.tab.c"
     break;
 
-  case 13:
-#line 133 "parser.y"
-    { 
-    stptr = SymTabLookupAll((yyvsp[(1) - (4)].chptr));
+  case 13: /* fprototype: Ident '(' parm_types ')'  */
+#line 165 "parser.y"
+                           { 
+    stptr = SymTabLookupAll((yyvsp[-3].chptr));
     if (stptr != NULL) {
-      errmsg("%s multiply declared", (yyvsp[(1) - (4)].chptr));
+      errmsg("%s multiply declared", (yyvsp[-3].chptr));
     }
     else {
       CurrScope = Local;
     }
  }
+#line 1500 "y.tab.c"
     break;
 
-  case 14:
-#line 145 "parser.y"
-    { (yyval.idlistptr) = NULL; }
+  case 14: /* parm_types: VOID  */
+#line 177 "parser.y"
+         { (yyval.idlistptr) = NULL; }
+#line 1506 "y.tab.c"
     break;
 
-  case 15:
-#line 146 "parser.y"
-    { (yyval.idlistptr) = (yyvsp[(1) - (1)].idlistptr); }
+  case 15: /* parm_types: nonempty_parm_type_list  */
+#line 178 "parser.y"
+                            { lptr = (yyvsp[0].idseq).head; (yyval.idlistptr) = lptr; }
+#line 1512 "y.tab.c"
     break;
 
-  case 16:
-#line 150 "parser.y"
-    { lptr = Attach((yyvsp[(1) - (3)].idlistptr), (yyvsp[(3) - (3)].idlistptr)); (yyval.idlistptr) = lptr; }
+  case 16: /* nonempty_parm_type_list: nonempty_parm_type_list comma parm_type_decl  */
+#line 186 "parser.y"
+                                               { (yyval.idseq) = LSeqAppend((yyvsp[-2].idseq), (yyvsp[0].idlistptr)); }
+#line 1518 "y.tab.c"
     break;
 
-  case 17:
-#line 151 "parser.y"
-    { (yyval.idlistptr) = (yyvsp[(1) - (1)].idlistptr); }
+  case 17: /* nonempty_parm_type_list: parm_type_decl  */
+#line 187 "parser.y"
+                   { (yyval.idseq) = LSeqAppend((llseq){NULL, NULL}, (yyvsp[0].idlistptr)); }
+#line 1524 "y.tab.c"
     break;
 
-  case 18:
-#line 155 "parser.y"
-    { lptr = NewListNode((yyvsp[(2) - (2)].chptr), (yyvsp[(1) - (2)].nval), false); (yyval.idlistptr) = lptr; }
+  case 18: /* parm_type_decl: type Ident  */
+#line 191 "parser.y"
+             { lptr = NewListNode((yyvsp[0].chptr), (yyvsp[-1].nval), false); (yyval.idlistptr) = lptr; }
+#line 1530 "y.tab.c"
     break;
 
-  case 19:
-#line 156 "parser.y"
-    { lptr = NewListNode((yyvsp[(2) - (4)].chptr), (yyvsp[(1) - (4)].nval), true); (yyval.idlistptr) = lptr; }
+  case 19: /* parm_type_decl: type Ident '[' ']'  */
+#line 192 "parser.y"
+                     { lptr = NewListNode((yyvsp[-2].chptr), (yyvsp[-3].nval), true); (yyval.idlistptr) = lptr; }
+#line 1536 "y.tab.c"
     break;
 
-  case 20:
-#line 161 "parser.y"
-    { (yyval.nval) = CurrType = t_Int; }
+  case 20: /* type: INT  */
+#line 197 "parser.y"
+         { (yyval.nval) = CurrType = t_Int; }
+#line 1542 "y.tab.c"
     break;
 
-  case 21:
-#line 162 "parser.y"
-    { (yyval.nval) = CurrType = t_Char; }
+  case 21: /* type: CHAR  */
+#line 198 "parser.y"
+          { (yyval.nval) = CurrType = t_Char; }
+#line 1548 "y.tab.c"
     break;
 
-  case 22:
-#line 163 "parser.y"
-    { (yyval.nval) = CurrType = t_None; }
+  case 22: /* type: VOID  */
+#line 199 "parser.y"
+          { (yyval.nval) = CurrType = t_None; }
+#line 1554 "y.tab.c"
     break;
 
-  case 26:
-#line 176 "parser.y"
-    {yyerrok;}
+  case 26: /* $@3: %empty  */
+#line 212 "parser.y"
+                  {yyerrok;}
+#line 1560 "y.tab.c"
     break;
 
-  case 28:
-#line 177 "parser.y"
-    {yyerrok;}
+  case 28: /* $@4: %empty  */
+#line 213 "parser.y"
+                {yyerrok;}
+#line 1566 "y.tab.c"
     break;
 
-  case 31:
-#line 182 "parser.y"
-    { 
+  case 31: /* id_decl: Ident  */
+#line 218 "parser.y"
+        { 
     if (CurrType == t_None) {
       errmsg("Illegal type [void] for variable %s", id_name);
     }
@@ -1705,11 +1579,12 @@ yyreduce:
       stptr->elt_type = t_None;
     }
   }
+#line 1582 "y.tab.c"
     break;
 
-  case 32:
-#line 193 "parser.y"
-    { 
+  case 32: /* id_decl: Ident '[' ArraySize ']'  */
+#line 229 "parser.y"
+                          { 
     if (CurrType == t_None) {
       errmsg("Illegal type [void] for variable %s", id_name);
     }
@@ -1718,74 +1593,99 @@ yyreduce:
       stptr->type = t_Array;
       stptr->formal = false;
       stptr->elt_type = CurrType;
-      stptr->num_elts = (yyvsp[(3) - (4)].nval);
+      stptr->num_elts = (yyvsp[-1].nval);
     }
   }
+#line 1599 "y.tab.c"
     break;
 
-  case 33:
-#line 207 "parser.y"
-    { (yyval.nval) = atoi(yytext); }
+  case 33: /* ArraySize: INTCON  */
+#line 243 "parser.y"
+                   { (yyval.nval) = ival; }
+#line 1605 "y.tab.c"
     break;
 
-  case 34:
-#line 211 "parser.y"
-    { (yyval.tptr) = mkListNode((yyvsp[(1) - (2)].tptr), (yyvsp[(2) - (2)].tptr)); }
+  case 34: /* stmt_list: stmts  */
+#line 254 "parser.y"
+          { (yyval.tseq) = (yyvsp[0].tseq); }
+#line 1611 "y.tab.c"
     break;
 
-  case 35:
-#line 212 "parser.y"
-    { (yyval.tptr) = NULL; }
+  case 35: /* stmt_list: %empty  */
+#line 255 "parser.y"
+    { (yyval.tseq) = (tnseq){NULL, NULL}; }
+#line 1617 "y.tab.c"
     break;
 
-  case 36:
-#line 216 "parser.y"
-    {
-      if ((yyvsp[(3) - (6)].tptr)->etype != t_Bool && (yyvsp[(3) - (6)].tptr)->etype != t_Error) {
+  case 36: /* stmts: stmts stmt  */
+#line 259 "parser.y"
+               { (yyval.tseq) = SeqAppend((yyvsp[-1].tseq), (yyvsp[0].tptr)); }
+#line 1623 "y.tab.c"
+    break;
+
+  case 37: /* stmts: stmt  */
+#line 260 "parser.y"
+         { (yyval.tseq) = SeqAppend((tnseq){NULL, NULL}, (yyvsp[0].tptr)); }
+#line 1629 "y.tab.c"
+    break;
+
+  case 38: /* stmt: IF '(' boolexp ')' stmt optional_else  */
+#line 264 "parser.y"
+                                        {
+      if ((yyvsp[-3].tptr)->etype != t_Bool && (yyvsp[-3].tptr)->etype != t_Error) {
         errmsg("conditional does not have Boolean type");
       }
-      (yyval.tptr) = mkSTNode(If, t_None, (yyvsp[(3) - (6)].tptr), (yyvsp[(5) - (6)].tptr), (yyvsp[(6) - (6)].tptr), NULL);
+      (yyval.tptr) = mkSTNode(If, t_None, (yyvsp[-3].tptr), (yyvsp[-1].tptr), (yyvsp[0].tptr), NULL);
     }
+#line 1640 "y.tab.c"
     break;
 
-  case 37:
-#line 222 "parser.y"
-    {
-      if ((yyvsp[(3) - (5)].tptr)->etype != t_Bool && (yyvsp[(3) - (5)].tptr)->etype != t_Error) {
+  case 39: /* stmt: WHILE '(' boolexp ')' stmt  */
+#line 270 "parser.y"
+                               {
+      if ((yyvsp[-2].tptr)->etype != t_Bool && (yyvsp[-2].tptr)->etype != t_Error) {
         errmsg("conditional does not have Boolean type");
       }
-      (yyval.tptr) = mkSTNode(While, t_None, (yyvsp[(3) - (5)].tptr), (yyvsp[(5) - (5)].tptr), NULL, NULL);
+      (yyval.tptr) = mkSTNode(While, t_None, (yyvsp[-2].tptr), (yyvsp[0].tptr), NULL, NULL);
     }
+#line 1651 "y.tab.c"
     break;
 
-  case 38:
-#line 228 "parser.y"
-    {
-      if ((yyvsp[(5) - (9)].tptr) != NULL && (yyvsp[(5) - (9)].tptr)->etype != t_Bool && (yyvsp[(5) - (9)].tptr)->etype != t_Error) {
+  case 40: /* $@5: %empty  */
+#line 277 "parser.y"
+    { if (share_exprs) ShareKill(); }
+#line 1657 "y.tab.c"
+    break;
+
+  case 41: /* stmt: FOR '(' optional_assgt semicolon optional_boolexp semicolon $@5 optional_assgt ')' stmt  */
+#line 278 "parser.y"
+                            {
+      if ((yyvsp[-5].tptr) != NULL && (yyvsp[-5].tptr)->etype != t_Bool && (yyvsp[-5].tptr)->etype != t_Error) {
         errmsg("conditional does not have Boolean type");
       }
-      (yyval.tptr) = mkSTNode(For, t_None, (yyvsp[(3) - (9)].tptr), (yyvsp[(5) - (9)].tptr), (yyvsp[(7) - (9)].tptr), (yyvsp[(9) - (9)].tptr));
+      (yyval.tptr) = mkSTNode(For, t_None, (yyvsp[-7].tptr), (yyvsp[-5].tptr), (yyvsp[-2].tptr), (yyvsp[0].tptr));
     }
+#line 1668 "y.tab.c"
     break;
 
-  case 39:
-#line 234 "parser.y"
-    {
+  case 42: /* stmt: RETURN optional_expr semicolon  */
+#line 284 "parser.y"
+                                   {
       if (currFun->ret_type != t_None) {
-	if ((yyvsp[(2) - (3)].tptr) == NULL) {
+	if ((yyvsp[-1].tptr) == NULL) {
 	  errmsg("return with no return value in non-void function");
           (yyval.tptr) = mkErrorNode();
 	}
-	else if ( !((yyvsp[(2) - (3)].tptr)->etype == t_Int || (yyvsp[(2) - (3)].tptr)->etype == t_Char || (yyvsp[(2) - (3)].tptr)->etype == t_Error) ) {
+	else if ( !((yyvsp[-1].tptr)->etype == t_Int || (yyvsp[-1].tptr)->etype == t_Char || (yyvsp[-1].tptr)->etype == t_Error) ) {
 	  errmsg("illegal return type");
           (yyval.tptr) = mkErrorNode();
 	}
 	else {
-	  (yyval.tptr) = mkSTNode(Return, (yyvsp[(2) - (3)].tptr)->etype, (yyvsp[(2) - (3)].tptr), NULL, NULL, NULL);
+	  (yyval.tptr) = mkSTNode(Return, (yyvsp[-1].tptr)->etype, (yyvsp[-1].tptr), NULL, NULL, NULL);
 	}
       }
       else {
-	if ((yyvsp[(2) - (3)].tptr) != NULL) {    /* there is a return expression  */
+	if ((yyvsp[-1].tptr) != NULL) {    /* there is a return expression  */
 	  errmsg("non-void return expression in function with no return value");
           (yyval.tptr) = mkErrorNode();
 	}
@@ -1794,235 +1694,283 @@ yyreduce:
 	}
       }
     }
+#line 1697 "y.tab.c"
     break;
 
-  case 40:
-#line 258 "parser.y"
-    { (yyval.tptr) = (yyvsp[(1) - (2)].tptr); }
+  case 43: /* stmt: assignment semicolon  */
+#line 308 "parser.y"
+                         { (yyval.tptr) = (yyvsp[-1].tptr); }
+#line 1703 "y.tab.c"
     break;
 
-  case 41:
-#line 259 "parser.y"
-    { (yyval.tptr) = (yyvsp[(1) - (2)].tptr); }
+  case 44: /* stmt: proc_call semicolon  */
+#line 309 "parser.y"
+                         { (yyval.tptr) = (yyvsp[-1].tptr); }
+#line 1709 "y.tab.c"
     break;
 
-  case 42:
-#line 260 "parser.y"
-    { (yyval.tptr) = (yyvsp[(1) - (1)].tptr); }
+  case 45: /* stmt: compound_stmt  */
+#line 310 "parser.y"
+                         { (yyval.tptr) = (yyvsp[0].tptr); }
+#line 1715 "y.tab.c"
     break;
 
-  case 43:
-#line 261 "parser.y"
-    { (yyval.tptr) = NULL; }
+  case 46: /* stmt: ';'  */
+#line 311 "parser.y"
+                         { (yyval.tptr) = NULL; }
+#line 1721 "y.tab.c"
     break;
 
-  case 44:
-#line 262 "parser.y"
-    { (yyval.tptr) = mkErrorNode(); }
+  case 47: /* stmt: error  */
+#line 312 "parser.y"
+                         { (yyval.tptr) = mkErrorNode(); }
+#line 1727 "y.tab.c"
     break;
 
-  case 46:
-#line 271 "parser.y"
+  case 49: /* $@6: %empty  */
+#line 321 "parser.y"
     {errstate = NOSEMICOLON;}
+#line 1733 "y.tab.c"
     break;
 
-  case 49:
-#line 276 "parser.y"
+  case 52: /* $@7: %empty  */
+#line 326 "parser.y"
     {errstate = NOCOMMA;}
+#line 1739 "y.tab.c"
     break;
 
-  case 51:
-#line 280 "parser.y"
-    { (yyval.tptr) = (yyvsp[(2) - (3)].tptr); }
+  case 54: /* compound_stmt: block_start var_decls stmt_list '}'  */
+#line 341 "parser.y"
+                                        { 
+      SymTabExitScope((yyvsp[-3].nval)); 
+      (yyval.tptr) = (yyvsp[-1].tseq).head; 
+    }
+#line 1748 "y.tab.c"
     break;
 
-  case 52:
-#line 284 "parser.y"
-    { (yyval.tptr) = (yyvsp[(2) - (2)].tptr); }
+  case 55: /* block_start: '{'  */
+#line 348 "parser.y"
+         { (yyval.nval) = SymTabEnterScope(); }
+#line 1754 "y.tab.c"
+    break;
+
+  case 56: /* optional_else: ELSE stmt  */
+#line 352 "parser.y"
+               { (yyval.tptr) = (yyvsp[0].tptr); }
+#line 1760 "y.tab.c"
     break;
 
-  case 53:
-#line 285 "parser.y"
+  case 57: /* optional_else: %empty  */
+#line 353 "parser.y"
     { (yyval.tptr) = NULL; }
+#line 1766 "y.tab.c"
     break;
 
-  case 54:
-#line 289 "parser.y"
-    { (yyval.tptr) = (yyvsp[(1) - (1)].tptr); }
+  case 58: /* optional_assgt: assignment  */
+#line 357 "parser.y"
+               { (yyval.tptr) = (yyvsp[0].tptr); }
+#line 1772 "y.tab.c"
     break;
 
-  case 55:
-#line 290 "parser.y"
+  case 59: /* optional_assgt: %empty  */
+#line 358 "parser.y"
     { (yyval.tptr) = NULL; }
+#line 1778 "y.tab.c"
     break;
 
-  case 56:
-#line 294 "parser.y"
-    { (yyval.tptr) = (yyvsp[(1) - (1)].tptr); }
+  case 60: /* optional_expr: expr  */
+#line 362 "parser.y"
+          { (yyval.tptr) = (yyvsp[0].tptr); }
+#line 1784 "y.tab.c"
     break;
 
-  case 57:
-#line 295 "parser.y"
-    { (yyval.tptr) = NULL; }
+  case 61: /* optional_expr: %empty  */
+#line 363 "parser.y"
+      { (yyval.tptr) = NULL; }
+#line 1790 "y.tab.c"
     break;
 
-  case 58:
-#line 299 "parser.y"
-    { (yyval.tptr) = (yyvsp[(1) - (1)].tptr); }
+  case 62: /* optional_boolexp: boolexp  */
+#line 367 "parser.y"
+            { (yyval.tptr) = (yyvsp[0].tptr); }
+#line 1796 "y.tab.c"
     break;
 
-  case 59:
-#line 300 "parser.y"
+  case 63: /* optional_boolexp: %empty  */
+#line 368 "parser.y"
     { (yyval.tptr) = NULL; }
+#line 1802 "y.tab.c"
     break;
 
-  case 60:
-#line 304 "parser.y"
-    {
-    if ((yyvsp[(1) - (3)].tptr)->ntype == Error) {
-      (yyval.tptr) = (yyvsp[(1) - (3)].tptr);
+  case 64: /* assignment: variable '=' expr  */
+#line 372 "parser.y"
+                    {
+    if ((yyvsp[-2].tptr)->ntype == Error) {
+      (yyval.tptr) = (yyvsp[-2].tptr);
     }
-    else if ((yyvsp[(3) - (3)].tptr)->ntype == Error) {
-      (yyval.tptr) = (yyvsp[(3) - (3)].tptr);
+    else if ((yyvsp[0].tptr)->ntype == Error) {
+      (yyval.tptr) = (yyvsp[0].tptr);
     }
-    else if (!((yyvsp[(1) - (3)].tptr)->etype == t_Int || (yyvsp[(1) - (3)].tptr)->etype == t_Char)) {
+    else if (!((yyvsp[-2].tptr)->etype == t_Int || (yyvsp[-2].tptr)->etype == t_Char)) {
       errmsg("invalid LHS in assignment");
       (yyval.tptr) = mkErrorNode();
     }
-    else if (!((yyvsp[(3) - (3)].tptr)->etype == t_Int || (yyvsp[(3) - (3)].tptr)->etype == t_Char)) {
+    else if (!((yyvsp[0].tptr)->etype == t_Int || (yyvsp[0].tptr)->etype == t_Char)) {
       errmsg("invalid RHS in assignment");
       (yyval.tptr) = mkErrorNode();
     }
     else {
-      (yyval.tptr) = mkExprNode(Assg, t_None, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr));
+      (yyval.tptr) = mkExprNode(Assg, t_None, (yyvsp[-2].tptr), (yyvsp[0].tptr));
     }
   }
+#line 1826 "y.tab.c"
     break;
 
-  case 61:
-#line 326 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(Equals, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 65: /* boolexp: expr EQ expr  */
+#line 394 "parser.y"
+                    { (yyval.tptr) = SynTreeBinExp(Equals, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1832 "y.tab.c"
     break;
 
-  case 62:
-#line 327 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(Neq, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 66: /* boolexp: expr NEQ expr  */
+#line 395 "parser.y"
+                    { (yyval.tptr) = SynTreeBinExp(Neq, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1838 "y.tab.c"
     break;
 
-  case 63:
-#line 328 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(Leq, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 67: /* boolexp: expr LE expr  */
+#line 396 "parser.y"
+                    { (yyval.tptr) = SynTreeBinExp(Leq, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1844 "y.tab.c"
     break;
 
-  case 64:
-#line 329 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(Geq, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 68: /* boolexp: expr GE expr  */
+#line 397 "parser.y"
+                    { (yyval.tptr) = SynTreeBinExp(Geq, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1850 "y.tab.c"
     break;
 
-  case 65:
-#line 330 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(Lt, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 69: /* boolexp: expr '<' expr  */
+#line 398 "parser.y"
+                    { (yyval.tptr) = SynTreeBinExp(Lt, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1856 "y.tab.c"
     break;
 
-  case 66:
-#line 331 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(Gt, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 70: /* boolexp: expr '>' expr  */
+#line 399 "parser.y"
+                    { (yyval.tptr) = SynTreeBinExp(Gt, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1862 "y.tab.c"
     break;
 
-  case 67:
-#line 332 "parser.y"
-    { (yyval.tptr) = SynTreeUnExp(LogicalNot, (yyvsp[(2) - (2)].tptr)); }
+  case 71: /* boolexp: '!' boolexp  */
+#line 400 "parser.y"
+                              { (yyval.tptr) = SynTreeUnExp(LogicalNot, (yyvsp[0].tptr)); }
+#line 1868 "y.tab.c"
     break;
 
-  case 68:
-#line 333 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(LogicalAnd, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 72: /* boolexp: boolexp AND boolexp  */
+#line 401 "parser.y"
+                         { (yyval.tptr) = SynTreeBinExp(LogicalAnd, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1874 "y.tab.c"
     break;
 
-  case 69:
-#line 334 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(LogicalOr, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 73: /* boolexp: boolexp OR boolexp  */
+#line 402 "parser.y"
+                         { (yyval.tptr) = SynTreeBinExp(LogicalOr, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1880 "y.tab.c"
     break;
 
-  case 70:
-#line 335 "parser.y"
-    { (yyval.tptr) = (yyvsp[(2) - (3)].tptr); }
+  case 74: /* boolexp: '(' boolexp ')'  */
+#line 403 "parser.y"
+                    { (yyval.tptr) = (yyvsp[-1].tptr); }
+#line 1886 "y.tab.c"
     break;
 
-  case 71:
-#line 339 "parser.y"
-    { (yyval.tptr) = SynTreeUnExp(UnaryMinus, (yyvsp[(2) - (2)].tptr)); }
+  case 75: /* expr: '-' expr  */
+#line 407 "parser.y"
+                              { (yyval.tptr) = SynTreeUnExp(UnaryMinus, (yyvsp[0].tptr)); }
+#line 1892 "y.tab.c"
     break;
 
-  case 72:
-#line 340 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(Plus, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 76: /* expr: expr '+' expr  */
+#line 408 "parser.y"
+                    { (yyval.tptr) = SynTreeBinExp(Plus, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1898 "y.tab.c"
     break;
 
-  case 73:
-#line 341 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(BinaryMinus, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 77: /* expr: expr '-' expr  */
+#line 409 "parser.y"
+                    { (yyval.tptr) = SynTreeBinExp(BinaryMinus, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1904 "y.tab.c"
     break;
 
-  case 74:
-#line 342 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(Mult, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 78: /* expr: expr '*' expr  */
+#line 410 "parser.y"
+                    { (yyval.tptr) = SynTreeBinExp(Mult, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1910 "y.tab.c"
     break;
 
-  case 75:
-#line 343 "parser.y"
-    { (yyval.tptr) = SynTreeBinExp(Div, (yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 79: /* expr: expr '/' expr  */
+#line 411 "parser.y"
+                    { (yyval.tptr) = SynTreeBinExp(Div, (yyvsp[-2].tptr), (yyvsp[0].tptr)); }
+#line 1916 "y.tab.c"
     break;
 
-  case 76:
-#line 344 "parser.y"
-    { (yyval.tptr) = (yyvsp[(1) - (1)].tptr); }
+  case 80: /* expr: fun_call  */
+#line 412 "parser.y"
+                    { (yyval.tptr) = (yyvsp[0].tptr); }
+#line 1922 "y.tab.c"
     break;
 
-  case 77:
-#line 345 "parser.y"
-    { (yyval.tptr) = (yyvsp[(1) - (1)].tptr); }
+  case 81: /* expr: variable  */
+#line 413 "parser.y"
+                    { (yyval.tptr) = (yyvsp[0].tptr); }
+#line 1928 "y.tab.c"
     break;
 
-  case 78:
-#line 346 "parser.y"
-    { (yyval.tptr) = (yyvsp[(2) - (3)].tptr); }
+  case 82: /* expr: '(' expr ')'  */
+#line 414 "parser.y"
+                    { (yyval.tptr) = (yyvsp[-1].tptr); }
+#line 1934 "y.tab.c"
     break;
 
-  case 79:
-#line 347 "parser.y"
-    { (yyval.tptr) = mkErrorNode(); }
+  case 83: /* expr: '(' error ')'  */
+#line 415 "parser.y"
+                    { (yyval.tptr) = mkErrorNode(); }
+#line 1940 "y.tab.c"
     break;
 
-  case 80:
-#line 348 "parser.y"
-    { (yyval.tptr) = mkConstNode(Intcon, t_Int, ival); }
+  case 84: /* expr: INTCON  */
+#line 416 "parser.y"
+         { (yyval.tptr) = mkConstNode(Intcon, t_Int, ival); }
+#line 1946 "y.tab.c"
     break;
 
-  case 81:
-#line 349 "parser.y"
-    { (yyval.tptr) = mkConstNode(Charcon, t_Char, ival); }
+  case 85: /* expr: CHARCON  */
+#line 417 "parser.y"
+           { (yyval.tptr) = mkConstNode(Charcon, t_Char, ival); }
+#line 1952 "y.tab.c"
     break;
 
-  case 82:
-#line 350 "parser.y"
-    { yytext[strlen(yytext)-1] = '\0'; /* to remove the trailing " */
-               (yyval.tptr) = mkStrNode(strdup(yytext+1)); }
+  case 86: /* expr: STRINGCON  */
+#line 418 "parser.y"
+             { (yyval.tptr) = mkStrNode(strval); }
+#line 1958 "y.tab.c"
     break;
 
-  case 83:
-#line 355 "parser.y"
-    {
+  case 87: /* fun_call: Ident '(' ')'  */
+#line 422 "parser.y"
+                  {
       bool err_occurred = false;
-      stptr = SymTabLookupAll((yyvsp[(1) - (3)].chptr));
+      stptr = SymTabLookupAll((yyvsp[-2].chptr));
       if (stptr == NULL) {
 	err_occurred = true;
-        errmsg("%s undeclared", (yyvsp[(1) - (3)].chptr));
+        errmsg("%s undeclared", (yyvsp[-2].chptr));
       }
       else {
         if (stptr->type != t_Func) {
 	  err_occurred = true;
-	  errmsg("%s is not a function", (yyvsp[(1) - (3)].chptr));
+	  errmsg("%s is not a function", (yyvsp[-2].chptr));
         }
         else {
 	  err_occurred = !ActualsMatchFormals(stptr, NULL);
@@ -2036,62 +1984,65 @@ yyreduce:
 	(yyval.tptr) = mkErrorNode();
       }
     }
+#line 1987 "y.tab.c"
     break;
 
-  case 84:
-#line 379 "parser.y"
-    {
+  case 88: /* fun_call: Ident '(' expr_list ')'  */
+#line 446 "parser.y"
+                            {
       bool err_occurred = false;
-      stptr = SymTabLookupAll((yyvsp[(1) - (4)].chptr));
+      stptr = SymTabLookupAll((yyvsp[-3].chptr));
       if (stptr == NULL) {
 	err_occurred = true;
-        errmsg("%s undeclared", (yyvsp[(1) - (4)].chptr));
+        errmsg("%s undeclared", (yyvsp[-3].chptr));
       }
       else if (stptr->type != t_Func) {
 	err_occurred = true;
-        errmsg("%s is not a function", (yyvsp[(1) - (4)].chptr));
+        errmsg("%s is not a function", (yyvsp[-3].chptr));
       }
       else {
-	err_occurred = !ActualsMatchFormals(stptr, (yyvsp[(3) - (4)].tptr));
+	err_occurred = !ActualsMatchFormals(stptr, (yyvsp[-1].tseq).head);
       }
 
       if (!err_occurred) {
-	(yyval.tptr) = mkSymTabRefNode(FunCall, stptr->ret_type, stptr, (yyvsp[(3) - (4)].tptr));
+	(yyval.tptr) = mkSymTabRefNode(FunCall, stptr->ret_type, stptr, (yyvsp[-1].tseq).head);
       }
       else {
 	(yyval.tptr) = mkErrorNode();
       }
     }
+#line 2014 "y.tab.c"
     break;
 
-  case 85:
-#line 401 "parser.y"
-    {
-      stptr = SymTabLookupAll((yyvsp[(1) - (4)].chptr));
+  case 89: /* fun_call: Ident '(' error ')'  */
+#line 468 "parser.y"
+                         {
+      stptr = SymTabLookupAll((yyvsp[-3].chptr));
       if (stptr == NULL) {
-        errmsg("undeclared identifier %s", (yyvsp[(1) - (4)].chptr));
+        errmsg("undeclared identifier %s", (yyvsp[-3].chptr));
       }
 
       (yyval.tptr) = mkErrorNode();
     }
+#line 2027 "y.tab.c"
     break;
 
-  case 86:
-#line 412 "parser.y"
-    {
+  case 90: /* proc_call: Ident '(' ')'  */
+#line 479 "parser.y"
+                  {
       bool err_occurred = false;
-      stptr = SymTabLookupAll((yyvsp[(1) - (3)].chptr));
+      stptr = SymTabLookupAll((yyvsp[-2].chptr));
       if (stptr == NULL) {
-        errmsg("undeclared identifier %s", (yyvsp[(1) - (3)].chptr));
+        errmsg("undeclared identifier %s", (yyvsp[-2].chptr));
         (yyval.tptr) = mkErrorNode();
       }
       else if (stptr->type != t_Func) {
 	err_occurred = true;
-        errmsg("%s is not a function", (yyvsp[(1) - (3)].chptr));
+        errmsg("%s is not a function", (yyvsp[-2].chptr));
       }
       else if (stptr->ret_type != t_None) {
 	err_occurred = true;
-	errmsg("non-VOID function %s used in a statement", (yyvsp[(1) - (3)].chptr));
+	errmsg("non-VOID function %s used in a statement", (yyvsp[-2].chptr));
       }
       else {
 	err_occurred = !ActualsMatchFormals(stptr, NULL);
@@ -2104,82 +2055,86 @@ yyreduce:
 	(yyval.tptr) = mkErrorNode();
       }
     }
+#line 2058 "y.tab.c"
     break;
 
-  case 87:
-#line 438 "parser.y"
-    {
+  case 91: /* proc_call: Ident '(' expr_list ')'  */
+#line 505 "parser.y"
+                             {
       bool err_occurred = false;
-      stptr = SymTabLookupAll((yyvsp[(1) - (4)].chptr));
+      stptr = SymTabLookupAll((yyvsp[-3].chptr));
       if (stptr == NULL) {
-        errmsg("undeclared identifier %s", (yyvsp[(1) - (4)].chptr));
+        errmsg("undeclared identifier %s", (yyvsp[-3].chptr));
         (yyval.tptr) = mkErrorNode();
       }
       else if (stptr->type != t_Func) {
 	err_occurred = true;
-        errmsg("%s is not a function", (yyvsp[(1) - (4)].chptr));
+        errmsg("%s is not a function", (yyvsp[-3].chptr));
       }
       else if (stptr->ret_type != t_None) {
 	err_occurred = true;
-	errmsg("non-VOID function %s used in a statement", (yyvsp[(1) - (4)].chptr));
+	errmsg("non-VOID function %s used in a statement", (yyvsp[-3].chptr));
       }
       else {
-	err_occurred = !ActualsMatchFormals(stptr, (yyvsp[(3) - (4)].tptr));
+	err_occurred = !ActualsMatchFormals(stptr, (yyvsp[-1].tseq).head);
       }
 
       if (!err_occurred) {
-	(yyval.tptr) = mkSymTabRefNode(FunCall, stptr->ret_type, stptr, (yyvsp[(3) - (4)].tptr));
+	(yyval.tptr) = mkSymTabRefNode(FunCall, stptr->ret_type, stptr, (yyvsp[-1].tseq).head);
       }
       else {
 	(yyval.tptr) = mkErrorNode();
       }
     }
+#line 2089 "y.tab.c"
     break;
 
-  case 88:
-#line 464 "parser.y"
-    {
-    stptr = SymTabLookupAll((yyvsp[(1) - (4)].chptr));
+  case 92: /* proc_call: Ident '(' error ')'  */
+#line 531 "parser.y"
+                        {
+    stptr = SymTabLookupAll((yyvsp[-3].chptr));
     if (stptr == NULL) {
-      errmsg("undeclared identifier %s", (yyvsp[(1) - (4)].chptr));
+      errmsg("undeclared identifier %s", (yyvsp[-3].chptr));
     }
 
     (yyval.tptr) = mkErrorNode();
   }
+#line 2102 "y.tab.c"
     break;
 
-  case 89:
-#line 475 "parser.y"
-    { 
-	stptr = SymTabLookupAll((yyvsp[(1) - (1)].chptr));
+  case 93: /* variable: Ident  */
+#line 542 "parser.y"
+           { 
+	stptr = SymTabLookupAll((yyvsp[0].chptr));
 	if (stptr == NULL) {
-	  errmsg("Undeclared variable: %s", (yyvsp[(1) - (1)].chptr));
+	  errmsg("Undeclared variable: %s", (yyvsp[0].chptr));
 	  (yyval.tptr) = mkErrorNode();
 	}
 	else {
 	  (yyval.tptr) = mkSymTabRefNode(Var, stptr->type, stptr, NULL);
 	}
     }
+#line 2117 "y.tab.c"
     break;
 
-  case 90:
-#line 485 "parser.y"
-    {
+  case 94: /* variable: Ident '[' expr ']'  */
+#line 552 "parser.y"
+                       {
 	bool err_occurred = false;
 
-	stptr = SymTabLookupAll((yyvsp[(1) - (4)].chptr));
+	stptr = SymTabLookupAll((yyvsp[-3].chptr));
 
 	if (stptr == NULL) {
-	  errmsg("Undeclared variable: %s", (yyvsp[(1) - (4)].chptr));
+	  errmsg("Undeclared variable: %s", (yyvsp[-3].chptr));
 	  err_occurred = true;
 	}
 	else if (stptr->type != t_Array) {
-	  errmsg("%s not declared as an array", (yyvsp[(1) - (4)].chptr));
+	  errmsg("%s not declared as an array", (yyvsp[-3].chptr));
 	  err_occurred = true;
 	}
-	if ( !((yyvsp[(3) - (4)].tptr)->etype == t_Int || (yyvsp[(3) - (4)].tptr)->etype == t_Char) ) {
-	  if ((yyvsp[(3) - (4)].tptr)->etype != t_Error) {
-	    errmsg("subscript to array %s must be of type int or char", (yyvsp[(1) - (4)].chptr));
+	if ( !((yyvsp[-1].tptr)->etype == t_Int || (yyvsp[-1].tptr)->etype == t_Char) ) {
+	  if ((yyvsp[-1].tptr)->etype != t_Error) {
+	    errmsg("subscript to array %s must be of type int or char", (yyvsp[-3].chptr));
 	    err_occurred = 1;
 	  }
 	}
@@ -2188,138 +2143,118 @@ yyreduce:
 	  (yyval.tptr) = mkErrorNode();
 	}
 	else {
-	  (yyval.tptr) = mkSymTabRefNode(ArraySubscript, stptr->elt_type, stptr, (yyvsp[(3) - (4)].tptr));
+	  (yyval.tptr) = mkSymTabRefNode(ArraySubscript, stptr->elt_type, stptr, (yyvsp[-1].tptr));
 	}
     }
+#line 2149 "y.tab.c"
     break;
 
-  case 91:
-#line 512 "parser.y"
-    {
-	stptr = SymTabLookupAll((yyvsp[(1) - (4)].chptr));
+  case 95: /* variable: Ident '[' error ']'  */
+#line 579 "parser.y"
+                        {
+	stptr = SymTabLookupAll((yyvsp[-3].chptr));
 
 	if (stptr == NULL) {
-	  errmsg("Undeclared variable: %s", (yyvsp[(1) - (4)].chptr));
+	  errmsg("Undeclared variable: %s", (yyvsp[-3].chptr));
 	}
 	else if (stptr->type != t_Array) {
-	  errmsg("%s not declared as an array", (yyvsp[(1) - (4)].chptr));
+	  errmsg("%s not declared as an array", (yyvsp[-3].chptr));
 	}
 
 	(yyval.tptr) = mkErrorNode();
     }
+#line 2166 "y.tab.c"
     break;
 
-  case 92:
-#line 527 "parser.y"
-    { (yyval.tptr) = mkListNode((yyvsp[(1) - (3)].tptr), (yyvsp[(3) - (3)].tptr)); }
+  case 96: /* expr_list: expr_list comma expr  */
+#line 594 "parser.y"
+                         { (yyval.tseq) = SeqAppend((yyvsp[-2].tseq), (yyvsp[0].tptr)); }
+#line 2172 "y.tab.c"
     break;
 
-  case 93:
-#line 528 "parser.y"
-    { (yyval.tptr) = mkListNode((yyvsp[(1) - (1)].tptr), NULL); }
+  case 97: /* expr_list: expr  */
+#line 595 "parser.y"
+             { (yyval.tseq) = SeqAppend((tnseq){NULL, NULL}, (yyvsp[0].tptr)); }
+#line 2178 "y.tab.c"
     break;
 
-  case 94:
-#line 531 "parser.y"
-    { (yyval.chptr) = id_name; }
+  case 98: /* Ident: ID  */
+#line 598 "parser.y"
+           { (yyval.chptr) = id_name; }
+#line 2184 "y.tab.c"
     break;
 
 
-/* Line 1267 of yacc.c.  */
-#line 2230 "y.tab.c"
+#line 2188 "y.tab.c"
+
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
-      /* If just tried and failed to reuse look-ahead token after an
-	 error, discard it.  */
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
     }
 
-  /* Else will try to reuse look-ahead token after shifting the error
+  /* Else will try to reuse lookahead token after shifting the error
      token.  */
   goto yyerrlab1;
 
@@ -2328,14 +2263,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -2348,42 +2282,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2394,53 +2328,56 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#ifndef yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
-  if (yychar != YYEOF && yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
-  /* Do not reclaim the symbols of the rule which action triggered
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
 
+  return yyresult;
+}
 
-#line 533 "parser.y"
-
+#line 600 "parser.y"
 
 